@@ -13,13 +13,17 @@
 /** \defgroup Distributed-Boundaries Distributed Boundary Conditions
  */
 
+#include <cassert>
+#include <map>
 #include <memory>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "../common/boollist.hpp"
 #include "../common/halo_descriptor.hpp"
 #include "../common/timer/timer.hpp"
+#include "../common/tuple_util.hpp"
 #include "../gcl/halo_exchange.hpp"
 #include "bound_bc.hpp"
 #include "grid_predicate.hpp"
@@ -74,17 +78,33 @@ namespace gridtools {
                 typename CTraits::comm_arch_type>;
 
           private:
+            using generic_pattern_type =
+                gcl::halo_exchange_generic<typename CTraits::proc_layout, typename CTraits::comm_arch_type>;
+            using field_type = gcl::field_on_the_fly<typename CTraits::value_type,
+                typename CTraits::data_layout,
+                generic_pattern_type::template traits>;
+
             using performance_meter_t = timer<typename CTraits::timer_impl_t>;
 
             array<halo_descriptor, 3> m_halos;
             array<int_t, 3> m_sizes;
             uint_t m_max_stores;
             std::unique_ptr<pattern_type> m_he;
+            std::unique_ptr<generic_pattern_type> m_he_generic;
 
             performance_meter_t m_meter_pack;
             performance_meter_t m_meter_exchange;
             performance_meter_t m_meter_bc;
 
+            struct exchanged_version {
+                std::weak_ptr<void const> store;
+                size_t version;
+            };
+
+            bool m_skip_unmodified = false;
+            std::map<void const *, exchanged_version> m_exchanged_versions;
+            size_t m_count_skipped = 0;
+
           public:
             /**
                 @brief Constructor of distributed_boundaries.
@@ -165,6 +185,13 @@ namespace gridtools {
                     throw std::runtime_error(err);
                 }
 
+                if (m_skip_unmodified) {
+                    exchange_modified(all_stores_for_exc);
+                    boundary_only(jobs...);
+                    record_versions(all_stores_for_exc);
+                    return;
+                }
+
                 m_meter_pack.start();
                 call_pack(all_stores_for_exc, std::make_integer_sequence<uint_t, sizeof...(jobs)>{});
                 m_meter_pack.pause();
@@ -178,8 +205,67 @@ namespace gridtools {
                 boundary_only(jobs...);
             }
 
+            /**
+                @brief Member function to perform the halo update of data stores with individual halos, boundary
+                conditions are not applied.
+
+                \param ptrs Pointers to the data of the data stores
+                \param halos The halos of each data store. They must have the same begin, end and total length as the
+                halos of this object, but can be narrower. Data stores with halos of width zero are skipped.
+            */
+            void exchange_halos(std::vector<typename CTraits::value_type *> const &ptrs,
+                std::vector<array<halo_descriptor, 3>> const &halos) {
+                assert(ptrs.size() == halos.size());
+                if (m_max_stores < ptrs.size()) {
+                    std::string err{"Too many data stores to be exchanged" + std::to_string(ptrs.size()) +
+                                    " instead of the maximum allowed, which is " + std::to_string(m_max_stores)};
+                    throw std::runtime_error(err);
+                }
+
+                std::vector<field_type> fields;
+                for (size_t i = 0; i != ptrs.size(); ++i)
+                    if (!is_empty(halos[i]))
+                        fields.emplace_back(ptrs[i], halos[i]);
+                if (fields.empty())
+                    return;
+
+                if (!m_he_generic) {
+                    m_he_generic = std::make_unique<generic_pattern_type>(m_he->comm());
+                    m_he_generic->setup(
+                        m_max_stores, field_type(nullptr, m_halos), sizeof(typename CTraits::value_type));
+                }
+
+                m_meter_pack.start();
+                m_he_generic->pack(fields);
+                m_meter_pack.pause();
+                m_meter_exchange.start();
+                m_he_generic->exchange();
+                m_meter_exchange.pause();
+                m_meter_pack.start();
+                m_he_generic->unpack(fields);
+                m_meter_pack.pause();
+            }
+
+            /**
+                @brief Enables or disables skipping the halo update of data stores that were not modified since their
+                last exchange by this object.
+
+                Modifications are tracked with the data store version counter (see `data_store::version`), which
+                counts mutable pointers and views handed out and `stencil::run` calls that write the store. Data
+                written through a pointer or view that was obtained before the last exchange is not detected.
+
+                A store is skipped only if it is unmodified on all ranks of the communicator, so the decision is
+                consistent across the ranks. This costs one `MPI_Allreduce` per `exchange` call.
+            */
+            void skip_unmodified(bool value = true) {
+                m_skip_unmodified = value;
+                m_exchanged_versions.clear();
+            }
+
             typename pattern_type::grid_type const &proc_grid() const { return m_he->comm(); }
 
+            array<halo_descriptor, 3> const &halos() const { return m_halos; }
+
             std::string print_meters() const {
                 return m_meter_pack.to_string() + "\n" + m_meter_exchange.to_string() + "\n" + m_meter_bc.to_string();
             }
@@ -191,6 +277,8 @@ namespace gridtools {
             size_t get_count_exchange() const { return m_meter_exchange.get_count(); }
             // no get_count_pack() as it is equivalent to get_count_exchange()
             size_t get_count_boundary() const { return m_meter_bc.get_count(); }
+            // number of data stores which halo update was skipped because they were not modified
+            size_t get_count_skipped() const { return m_count_skipped; }
 
             void reset_meters() {
                 m_meter_pack.reset_meter();
@@ -199,6 +287,13 @@ namespace gridtools {
             }
 
           private:
+            static bool is_empty(array<halo_descriptor, 3> const &halos) {
+                for (auto &&halo : halos)
+                    if (halo.minus() || halo.plus())
+                        return false;
+                return true;
+            }
+
             template <typename BoundaryApply, typename ArgsTuple, uint_t... Ids>
             static void call_apply(
                 BoundaryApply boundary_apply, ArgsTuple const &args, std::integer_sequence<uint_t, Ids...>) {
@@ -247,6 +342,62 @@ namespace gridtools {
 
             template <typename Stores>
             static void call_unpack(Stores const &stores, std::integer_sequence<uint_t>) {}
+
+            template <typename Store>
+            bool is_modified(Store const &store) const {
+                auto it = m_exchanged_versions.find(store.get());
+                return it == m_exchanged_versions.end() || it->second.store.expired() ||
+                       it->second.version != store->version();
+            }
+
+            template <typename Stores>
+            void exchange_modified(Stores const &stores) {
+                std::vector<int> modified;
+                tuple_util::for_each([&](auto const &store) { modified.push_back(is_modified(store)); }, stores);
+                if (modified.empty())
+                    return;
+                MPI_Allreduce(
+                    MPI_IN_PLACE, modified.data(), modified.size(), MPI_INT, MPI_LOR, m_he->comm().communicator());
+
+                std::vector<typename CTraits::value_type *> ptrs;
+                size_t i = 0;
+                tuple_util::for_each(
+                    [&](auto const &store) {
+                        if (modified[i++])
+                            ptrs.push_back(const_cast<typename CTraits::value_type *>(store->get_const_target_ptr()));
+                    },
+                    stores);
+                m_count_skipped += modified.size() - ptrs.size();
+                if (ptrs.empty())
+                    return;
+
+                m_meter_pack.start();
+                m_he->pack(ptrs);
+                m_meter_pack.pause();
+                m_meter_exchange.start();
+                m_he->exchange();
+                m_meter_exchange.pause();
+                m_meter_pack.start();
+                ptrs.clear();
+                i = 0;
+                tuple_util::for_each(
+                    [&](auto const &store) {
+                        if (modified[i++])
+                            ptrs.push_back(store->get_target_ptr());
+                    },
+                    stores);
+                m_he->unpack(ptrs);
+                m_meter_pack.pause();
+            }
+
+            template <typename Stores>
+            void record_versions(Stores const &stores) {
+                tuple_util::for_each(
+                    [&](auto const &store) {
+                        m_exchanged_versions[store.get()] = {store, store->version()};
+                    },
+                    stores);
+            }
         };
         /** @} */
     } // namespace boundaries
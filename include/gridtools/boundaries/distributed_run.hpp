@@ -0,0 +1,279 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../common/array.hpp"
+#include "../common/halo_descriptor.hpp"
+#include "../common/make_array.hpp"
+#include "../meta.hpp"
+#include "../stencil/common/extent.hpp"
+#include "../stencil/common/intent.hpp"
+#include "../stencil/frontend/make_grid.hpp"
+#include "../stencil/frontend/run.hpp"
+#include "distributed_boundaries.hpp"
+
+namespace gridtools {
+    namespace boundaries {
+        namespace distributed_run_impl_ {
+            template <size_t I>
+            struct arg {};
+
+            template <class Spec, size_t I>
+            using arg_extent_t = decltype(stencil::get_arg_extent(std::declval<Spec>(), arg<I>()));
+
+            template <class Spec, size_t I>
+            using arg_intent_t = decltype(stencil::get_arg_intent(std::declval<Spec>(), arg<I>()));
+
+            template <class Extent>
+            using is_zero_extent = bool_constant<Extent::iminus::value == 0 && Extent::iplus::value == 0 &&
+                                                 Extent::jminus::value == 0 && Extent::jplus::value == 0 &&
+                                                 Extent::kminus::value == 0 && Extent::kplus::value == 0>;
+
+            /*
+             * Every field that is read with a non-zero extent is exchanged, also if the computation writes it: the
+             * fields are written only on the grid, not in their halos.
+             */
+            template <class Spec, size_t I>
+            using needs_exchange = bool_constant<!is_zero_extent<arg_extent_t<Spec, I>>::value>;
+
+            /*
+             * The halos that are read with the given extent, but not wider than the given halos.
+             */
+            template <class Extent>
+            array<halo_descriptor, 3> narrow_halos(array<halo_descriptor, 3> const &halos, Extent) {
+                int_t minus[] = {-Extent::iminus::value, -Extent::jminus::value, -Extent::kminus::value};
+                int_t plus[] = {Extent::iplus::value, Extent::jplus::value, Extent::kplus::value};
+                array<halo_descriptor, 3> res;
+                for (size_t d = 0; d != 3; ++d)
+                    res[d] = halo_descriptor(std::min<int_t>(minus[d], halos[d].minus()),
+                        std::min<int_t>(plus[d], halos[d].plus()),
+                        halos[d].begin(),
+                        halos[d].end(),
+                        halos[d].total_length());
+                return res;
+            }
+
+            template <class CTraits, class Field>
+            void add_field(std::false_type,
+                array<halo_descriptor, 3> const &,
+                Field const &,
+                std::vector<typename CTraits::value_type *> &,
+                std::vector<array<halo_descriptor, 3>> &) {}
+
+            template <class CTraits, class Field>
+            void add_field(std::true_type,
+                array<halo_descriptor, 3> const &field_halos,
+                Field const &field,
+                std::vector<typename CTraits::value_type *> &ptrs,
+                std::vector<array<halo_descriptor, 3>> &halos) {
+                ptrs.push_back(field->get_target_ptr());
+                halos.push_back(field_halos);
+            }
+
+            template <class CTraits, class Comp, class Backend, class Grid, class... Fields, size_t... Is>
+            void distributed_run(distributed_boundaries<CTraits> &dist_bc,
+                Comp comp,
+                Backend &&be,
+                Grid const &grid,
+                std::index_sequence<Is...>,
+                Fields &&... fields) {
+                using spec_t = decltype(comp(arg<Is>()...));
+                std::vector<typename CTraits::value_type *> ptrs;
+                std::vector<array<halo_descriptor, 3>> halos;
+                using loop_t = int[sizeof...(Is)];
+                (void)loop_t{(add_field<CTraits>(needs_exchange<spec_t, Is>(),
+                                  narrow_halos(dist_bc.halos(), arg_extent_t<spec_t, Is>()),
+                                  fields,
+                                  ptrs,
+                                  halos),
+                    0)...};
+                dist_bc.exchange_halos(ptrs, halos);
+                stencil::run(comp, std::forward<Backend>(be), grid, std::forward<Fields>(fields)...);
+            }
+
+            template <class Spec, size_t I>
+            using exchanged_extent_t =
+                meta::if_<needs_exchange<Spec, I>, arg_extent_t<Spec, I>, stencil::extent<>>;
+
+            /*
+             * The part of the halo of a dimension, on both sides, where the time steps are computed.
+             */
+            struct widths {
+                int_t minus;
+                int_t plus;
+            };
+
+            template <class CTraits,
+                class Comp,
+                class Backend,
+                class Axis,
+                class Storage,
+                class... Fields,
+                size_t... Is>
+            size_t distributed_run_steps(distributed_boundaries<CTraits> &dist_bc,
+                size_t steps,
+                Comp comp,
+                Backend &&be,
+                Axis const &axis,
+                Storage &out,
+                Storage &in,
+                std::index_sequence<Is...>,
+                Fields &&... fields) {
+                using spec_t = decltype(comp(arg<0>(), arg<1>(), arg<Is + 2>()...));
+                static_assert(arg_intent_t<spec_t, 1>::value == stencil::intent::in,
+                    "the input of the time steps should be read only");
+                using in_extent_t = arg_extent_t<spec_t, 1>;
+                using fields_extent_t = stencil::enclosing_extent<exchanged_extent_t<spec_t, Is + 2>...>;
+
+                using proc_layout_t = typename CTraits::proc_layout;
+                auto has_neighbour = [&](int dim, int side) {
+                    auto eta = make_array(0, 0, 0);
+                    eta[dim] = side;
+                    return dist_bc.proc_grid().proc(
+                               eta[proc_layout_t::at(0)], eta[proc_layout_t::at(1)], eta[proc_layout_t::at(2)]) != -1;
+                };
+                // the halos on the sides without a neighbour are never exchanged, the domain is not extended there
+                auto on_neighbours = [&](size_t d, widths const &w) -> widths {
+                    return {has_neighbour(d, -1) ? w.minus : 0, has_neighbour(d, 1) ? w.plus : 0};
+                };
+
+                auto const &max_halos = dist_bc.halos();
+                widths shrink[2] = {on_neighbours(0, {-in_extent_t::iminus::value, in_extent_t::iplus::value}),
+                    on_neighbours(1, {-in_extent_t::jminus::value, in_extent_t::jplus::value})};
+                // the other fields are exchanged once, the time steps cannot read them beyond their halos
+                widths limit[2] = {on_neighbours(0,
+                                       {(int_t)max_halos[0].minus() + fields_extent_t::iminus::value,
+                                           (int_t)max_halos[0].plus() - fields_extent_t::iplus::value}),
+                    on_neighbours(1,
+                        {(int_t)max_halos[1].minus() + fields_extent_t::jminus::value,
+                            (int_t)max_halos[1].plus() - fields_extent_t::jplus::value})};
+                widths exchanged[2] = {on_neighbours(0, {(int_t)max_halos[0].minus(), (int_t)max_halos[0].plus()}),
+                    on_neighbours(1, {(int_t)max_halos[1].minus(), (int_t)max_halos[1].plus()})};
+                widths valid[2] = {};
+
+                auto next_widths = [&](size_t d) -> widths {
+                    return {std::min(valid[d].minus - shrink[d].minus, limit[d].minus),
+                        std::min(valid[d].plus - shrink[d].plus, limit[d].plus)};
+                };
+                auto is_computable = [&](widths const &w) { return w.minus >= 0 && w.plus >= 0; };
+
+                std::vector<typename CTraits::value_type *> ptrs;
+                std::vector<array<halo_descriptor, 3>> halos;
+                using loop_t = int[sizeof...(Is) + 1];
+                (void)loop_t{0,
+                    (add_field<CTraits>(needs_exchange<spec_t, Is + 2>(), max_halos, fields, ptrs, halos), 0)...};
+
+                size_t exchanges = 0;
+                for (size_t step = 0; step != steps; ++step) {
+                    widths w[2] = {next_widths(0), next_widths(1)};
+                    if (!exchanges || !is_computable(w[0]) || !is_computable(w[1])) {
+                        ptrs.push_back(in->get_target_ptr());
+                        halos.push_back(max_halos);
+                        dist_bc.exchange_halos(ptrs, halos);
+                        ptrs.clear();
+                        halos.clear();
+                        ++exchanges;
+                        valid[0] = exchanged[0];
+                        valid[1] = exchanged[1];
+                        w[0] = next_widths(0);
+                        w[1] = next_widths(1);
+                        if (!is_computable(w[0]) || !is_computable(w[1]))
+                            throw std::runtime_error("the halos are too narrow for the extents of the computation");
+                    }
+                    auto domain = [&](size_t d) {
+                        return halo_descriptor(0,
+                            0,
+                            max_halos[d].begin() - w[d].minus,
+                            max_halos[d].end() + w[d].plus,
+                            max_halos[d].total_length());
+                    };
+                    stencil::run(comp, be, stencil::make_grid(domain(0), domain(1), axis), out, in, fields...);
+                    valid[0] = w[0];
+                    valid[1] = w[1];
+                    std::swap(in, out);
+                }
+                return exchanges;
+            }
+        } // namespace distributed_run_impl_
+
+        /** \ingroup Distributed-Boundaries
+         * @{ */
+
+        /**
+            @brief Runs a stencil computation on a distributed domain.
+
+            Before the computation is run, the halos of the fields that it reads with a non-zero extent are updated by
+            `dist_bc`, also if the computation writes them later. The halo of each field is only as wide as the
+            extent with which the computation reads it, but not wider than the halos of `dist_bc`. The fields that are
+            read only at zero offset are not exchanged. Boundary conditions are not applied.
+
+            The arguments after `dist_bc` are the arguments of `stencil::run`. The fields that need a halo update
+            have to be data stores of the type that `dist_bc` exchanges.
+        */
+        template <class CTraits, class Comp, class Backend, class Grid, class... Fields>
+        void distributed_run(
+            distributed_boundaries<CTraits> &dist_bc, Comp comp, Backend &&be, Grid const &grid, Fields &&... fields) {
+            distributed_run_impl_::distributed_run(dist_bc,
+                comp,
+                std::forward<Backend>(be),
+                grid,
+                std::index_sequence_for<Fields...>(),
+                std::forward<Fields>(fields)...);
+        }
+
+        /**
+            @brief Runs time steps of a stencil computation on a distributed domain, exchanging the halos only once
+            every few steps.
+
+            Every time step computes `out` from `in` and the remaining fields, then the data stores `out` and `in` are
+            swapped: on return `in` holds the result of the last time step. The spec is called with `out`, `in` and
+            the remaining fields, in this order; `in` must be read only.
+
+            After an exchange the halos of `in` are valid up to the full width of the halos of `dist_bc`. Every time
+            step is computed on the domain extended into the halos by the part that is still valid, less the extent
+            with which the computation reads `in`, so the valid part shrinks at every step. The halos are exchanged
+            again only when it cannot shrink anymore. On the sides without a neighbouring process the domain is not
+            extended, and the halos of `in` keep the values of the physical boundary. With halos N times wider than
+            the extent of the computation the messages are sent once every N steps, at the cost of computing the
+            shrinking halo regions redundantly. The remaining fields that the computation reads with a non-zero extent
+            are exchanged once, with the first exchange of `in`.
+
+            \param dist_bc The distributed boundaries that exchange the halos, with the halos of the core domain
+            \param steps The number of time steps
+            \param axis The vertical axis or size, as in `make_grid`
+            \return The number of halo exchanges
+        */
+        template <class CTraits, class Comp, class Backend, class Axis, class Storage, class... Fields>
+        size_t distributed_run_steps(distributed_boundaries<CTraits> &dist_bc,
+            size_t steps,
+            Comp comp,
+            Backend &&be,
+            Axis const &axis,
+            Storage &out,
+            Storage &in,
+            Fields &&... fields) {
+            return distributed_run_impl_::distributed_run_steps(dist_bc,
+                steps,
+                comp,
+                std::forward<Backend>(be),
+                axis,
+                out,
+                in,
+                std::index_sequence_for<Fields...>(),
+                std::forward<Fields>(fields)...);
+        }
+        /** @} */
+    } // namespace boundaries
+} // namespace gridtools
@@ -0,0 +1,227 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "../common/array.hpp"
+#include "../common/generic_metafunctions/for_each.hpp"
+#include "../common/halo_descriptor.hpp"
+#include "../common/hymap.hpp"
+#include "../common/tuple_util.hpp"
+#include "../gcl/low_level/arch.hpp"
+#include "../meta.hpp"
+#include "../sid/concept.hpp"
+#include "../sid/sid_shift_origin.hpp"
+#include "../stencil/be_api.hpp"
+#include "../stencil/common/dim.hpp"
+#include "../stencil/cpu_kfirst.hpp"
+#include "apply.hpp"
+#include "bound_bc.hpp"
+#include "boundary.hpp"
+
+namespace gridtools {
+    namespace boundaries {
+        namespace fused_boundaries_impl_ {
+            template <typename Tuple>
+            using indices_of = std::make_index_sequence<std::tuple_size<std::decay_t<Tuple>>::value>;
+
+            template <typename BoundaryApply, typename Stores, size_t... Is>
+            void call_apply(BoundaryApply const &boundary_apply, Stores const &stores, std::index_sequence<Is...>) {
+                boundary_apply.apply(std::get<Is>(stores)...);
+            }
+
+            template <typename Arch, typename BoundBC>
+            void apply_boundary(array<halo_descriptor, 3> const &halos, BoundBC const &bc) {
+                using stores_t = typename BoundBC::stores_type;
+                call_apply(make_boundary<Arch>(halos, bc.boundary_to_apply()), bc.stores(), indices_of<stores_t>());
+            }
+
+            /*
+             * The part of the halo descriptor that belongs to the block [first, first + size): the core points in the
+             * block, and the halos on the sides where the block touches them.
+             */
+            inline halo_descriptor block_halo(halo_descriptor const &halo, int_t first, int_t size) {
+                int_t last = first + size - 1;
+                int_t begin = halo.begin();
+                int_t end = halo.end();
+                return halo_descriptor(first <= begin ? halo.minus() : 0,
+                    last >= end ? halo.plus() : 0,
+                    std::max(begin, first),
+                    std::min(end, last),
+                    halo.total_length());
+            }
+
+            template <class PlhInfo, class Extent = typename PlhInfo::extent_t>
+            using is_read_at_offset = bool_constant<!PlhInfo::is_tmp_t::value &&
+                                                    (Extent::iminus::value != 0 || Extent::iplus::value != 0 ||
+                                                        Extent::jminus::value != 0 || Extent::jplus::value != 0)>;
+
+            template <class T, class U>
+            bool same_origin(T *lhs, U *rhs) {
+                return static_cast<void const *>(lhs) == static_cast<void const *>(rhs);
+            }
+
+            // fields that are not plain pointers can not be told apart
+            template <class T, class U>
+            bool same_origin(T const &, U const &) {
+                return true;
+            }
+
+            /*
+             * Whether the computation reads any of the stores with a non-zero horizontal extent. The boundary of such
+             * a store can not be applied block by block: the neighbouring blocks read its halos.
+             */
+            template <class PlhMap, class Grid, class DataStores, class Stores>
+            bool any_read_at_offset(Grid const &grid, DataStores &data_stores, Stores const &stores) {
+                bool res = false;
+                tuple_util::for_each(
+                    [&](auto const &store) {
+                        auto shifted = sid::shift_sid_origin(store, grid.origin());
+                        auto origin = sid::get_origin(shifted)();
+                        for_each<meta::filter<is_read_at_offset, PlhMap>>([&](auto info) {
+                            using plh_t = typename decltype(info)::plh_t;
+                            res = res || same_origin(sid::get_origin(at_key<plh_t>(data_stores))(), origin);
+                        });
+                    },
+                    stores);
+                return res;
+            }
+
+            template <typename Stores, size_t... Is>
+            auto make_views(Stores const &stores, std::index_sequence<Is...>) {
+                return std::make_tuple(std::get<Is>(stores)->target_view()...);
+            }
+        } // namespace fused_boundaries_impl_
+
+        /** \ingroup Boundary-Conditions
+         * @{
+         */
+
+        /**
+           @brief A backend that applies boundary conditions to the fields that a computation writes, as part of the
+           computation.
+
+           It is created by `fuse_boundaries` and passed to `stencil::run` in place of the backend that it wraps.
+           With `stencil::cpu_kfirst` the boundary conditions are applied block by block: after the stages of a block,
+           to the halo points next to the block, while the edges of the fields that the block has just written are
+           still in cache. With other backends they are applied after the computation, as by `boundary::apply`.
+
+           \tparam Arch The target where the data is, as for `boundary`
+           \tparam Backend The backend that runs the computation
+           \tparam BoundBCs The boundary conditions with the data stores to apply them to, see `bind_bc`
+         */
+        template <class Arch, class Backend, class... BoundBCs>
+        struct fused_boundaries {
+            Backend backend;
+            array<halo_descriptor, 3> halos;
+            std::tuple<BoundBCs...> bcs;
+        };
+
+        /**
+           @brief Creates a backend that runs the computations with `backend` and applies the given boundary
+           conditions to the halos described by `halos` afterwards.
+
+           The boundary conditions are bound to their data stores by `bind_bc`, without placeholders, e.g.
+
+           \code
+           auto backend = fuse_boundaries<gcl::cpu>(cpu_kfirst<>(), halos, bind_bc(copy_boundary(), out, in));
+           run(spec, backend, grid, out, in);
+           \endcode
+
+           With `stencil::cpu_kfirst` the computation domain of the grid has to be the core of `halos` along the first
+           two dimensions, and the boundary functions may read the fields only at the points of the block of the
+           halo point, that is at most as far from the halo point as the block is wide along every dimension. A
+           boundary condition bound to a field that the computation reads with a non-zero horizontal extent is not
+           fused: the blocks that are still computed read the halos that it writes, so it is applied after the
+           computation.
+         */
+        template <class Arch, class Backend, class... BoundBCs>
+        fused_boundaries<Arch, Backend, BoundBCs...> fuse_boundaries(
+            Backend backend, array<halo_descriptor, 3> const &halos, BoundBCs... bcs) {
+            static_assert(conjunction<is_bound_bc<BoundBCs>...>::value, "the boundary conditions must be bound");
+            return {std::move(backend), halos, std::make_tuple(std::move(bcs)...)};
+        }
+
+        template <class Arch, class Backend, class... BoundBCs, class Spec, class Grid, class DataStores>
+        void gridtools_backend_entry_point(fused_boundaries<Arch, Backend, BoundBCs...> const &be,
+            Spec spec,
+            Grid const &grid,
+            DataStores data_stores) {
+            gridtools_backend_entry_point(be.backend, spec, grid, std::move(data_stores));
+            tuple_util::for_each(
+                [&](auto const &bc) { fused_boundaries_impl_::apply_boundary<Arch>(be.halos, bc); }, be.bcs);
+        }
+
+        template <class IBlockSize,
+            class JBlockSize,
+            class ThreadPool,
+            class... BoundBCs,
+            class Spec,
+            class Grid,
+            class DataStores>
+        void gridtools_backend_entry_point(
+            fused_boundaries<gcl::cpu, stencil::cpu_kfirst<IBlockSize, JBlockSize, ThreadPool>, BoundBCs...> const &be,
+            Spec spec,
+            Grid const &grid,
+            DataStores data_stores) {
+            using namespace fused_boundaries_impl_;
+            auto const &halos = be.halos;
+            int_t i_origin = at_key<stencil::dim::i>(grid.origin());
+            int_t j_origin = at_key<stencil::dim::j>(grid.origin());
+            auto covers = [](halo_descriptor const &halo, int_t origin, int_t size) {
+                return origin == (int_t)halo.begin() && origin + size == (int_t)halo.end() + 1;
+            };
+            if (!covers(halos[0], i_origin, grid.i_size()) || !covers(halos[1], j_origin, grid.j_size()))
+                throw std::runtime_error("fused boundaries: the grid should cover the core of the halo descriptors");
+            using plh_map_t = typename stencil::be_api::make_split_view<Spec>::plh_map_t;
+            auto deferred = tuple_util::transform(
+                [&](auto const &bc) { return any_read_at_offset<plh_map_t>(grid, data_stores, bc.stores()); },
+                be.bcs);
+            // the boundary functions with the views of their fields
+            auto bc_views = tuple_util::transform(
+                [](auto const &bc) {
+                    auto views = make_views(bc.stores(), indices_of<decltype(bc.stores())>());
+                    return std::make_pair(bc.boundary_to_apply(), std::move(views));
+                },
+                be.bcs);
+            stencil::cpu_kfirst_backend::run_blocks<IBlockSize, JBlockSize, ThreadPool>(spec,
+                grid,
+                std::move(data_stores),
+                [&](int_t i_begin, int_t i_size, int_t j_begin, int_t j_size) {
+                    array<halo_descriptor, 3> block_halos = {block_halo(halos[0], i_origin + i_begin, i_size),
+                        block_halo(halos[1], j_origin + j_begin, j_size),
+                        halos[2]};
+                    tuple_util::for_each(
+                        [&](auto const &item, bool is_deferred) {
+                            if (is_deferred)
+                                return;
+                            using function_t = std::decay_t<decltype(item.first)>;
+                            call_apply(boundary_apply<function_t>(block_halos, item.first),
+                                item.second,
+                                indices_of<decltype(item.second)>());
+                        },
+                        bc_views,
+                        deferred);
+                });
+            tuple_util::for_each(
+                [&](auto const &bc, bool is_deferred) {
+                    if (is_deferred)
+                        apply_boundary<gcl::cpu>(halos, bc);
+                },
+                be.bcs,
+                deferred);
+        }
+        /** @} */
+    } // namespace boundaries
+} // namespace gridtools
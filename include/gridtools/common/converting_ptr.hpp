@@ -0,0 +1,113 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "defs.hpp"
+#include "host_device.hpp"
+
+/**
+ *  Pointer and reference proxies for mixed precision data.
+ *
+ *  The data is stored as `Stored` but read and written as `Compute`. Dereferencing a `converting_ptr` gives a
+ *  `converting_ref` that converts the stored value on read and converts back on write. The conversions are done with
+ *  `static_cast`, therefore `Stored` can also be a user defined compact type (like a scaled 16 bit integer) that is
+ *  explicitly convertible from and to `Compute`.
+ */
+namespace gridtools {
+    template <class Compute, class Stored>
+    struct converting_ref {
+        Stored *m_ptr;
+
+        GT_FUNCTION converting_ref(Stored *ptr) : m_ptr(ptr) {}
+        converting_ref(converting_ref const &) = default;
+
+        GT_FUNCTION operator Compute() const { return static_cast<Compute>(*m_ptr); }
+
+        template <class S = Stored, std::enable_if_t<!std::is_const<S>::value, int> = 0>
+        GT_FUNCTION converting_ref const &operator=(Compute const &value) const {
+            *m_ptr = static_cast<Stored>(value);
+            return *this;
+        }
+
+        // reference semantics: assigns the value, not the pointer
+        GT_FUNCTION converting_ref const &operator=(converting_ref const &other) const {
+            return *this = static_cast<Compute>(other);
+        }
+
+        template <class T>
+        GT_FUNCTION converting_ref const &operator+=(T const &rhs) const {
+            return *this = static_cast<Compute>(*this) + rhs;
+        }
+        template <class T>
+        GT_FUNCTION converting_ref const &operator-=(T const &rhs) const {
+            return *this = static_cast<Compute>(*this) - rhs;
+        }
+        template <class T>
+        GT_FUNCTION converting_ref const &operator*=(T const &rhs) const {
+            return *this = static_cast<Compute>(*this) * rhs;
+        }
+        template <class T>
+        GT_FUNCTION converting_ref const &operator/=(T const &rhs) const {
+            return *this = static_cast<Compute>(*this) / rhs;
+        }
+    };
+
+    template <class Compute, class Stored>
+    struct converting_ptr {
+        Stored *m_ptr;
+
+        GT_FUNCTION Stored *get() const { return m_ptr; }
+
+        GT_FUNCTION converting_ref<Compute, Stored> operator*() const { return {m_ptr}; }
+        GT_FUNCTION converting_ref<Compute, Stored> operator[](std::ptrdiff_t i) const { return {m_ptr + i}; }
+
+        GT_FUNCTION converting_ptr &operator+=(std::ptrdiff_t offset) {
+            m_ptr += offset;
+            return *this;
+        }
+        GT_FUNCTION converting_ptr &operator-=(std::ptrdiff_t offset) {
+            m_ptr -= offset;
+            return *this;
+        }
+        GT_FUNCTION converting_ptr &operator++() {
+            ++m_ptr;
+            return *this;
+        }
+        GT_FUNCTION converting_ptr &operator--() {
+            --m_ptr;
+            return *this;
+        }
+
+        friend GT_FUNCTION converting_ptr operator+(converting_ptr obj, std::ptrdiff_t offset) {
+            return {obj.m_ptr + offset};
+        }
+        friend GT_FUNCTION std::ptrdiff_t operator-(converting_ptr lhs, converting_ptr rhs) {
+            return lhs.m_ptr - rhs.m_ptr;
+        }
+        friend GT_FUNCTION bool operator==(converting_ptr lhs, converting_ptr rhs) { return lhs.m_ptr == rhs.m_ptr; }
+        friend GT_FUNCTION bool operator!=(converting_ptr lhs, converting_ptr rhs) { return lhs.m_ptr != rhs.m_ptr; }
+    };
+
+    /**
+     *  `Stored *` if no conversion is needed, `converting_ptr<Compute, Stored>` otherwise
+     */
+    template <class Compute, class Stored>
+    using converting_ptr_type = std::conditional_t<std::is_same<Compute, std::remove_const_t<Stored>>::value,
+        Stored *,
+        converting_ptr<Compute, Stored>>;
+
+    template <class Compute, class Stored>
+    GT_CONSTEXPR GT_FUNCTION converting_ptr_type<Compute, Stored> make_converting_ptr(Stored *ptr) {
+        return {ptr};
+    }
+} // namespace gridtools
@@ -149,6 +149,14 @@ namespace gridtools {
         using std::sqrt;
 #endif
 
+#ifdef __CUDA_ARCH__
+        GT_FUNCTION_DEVICE float fma(float x, float y, float z) { return ::fmaf(x, y, z); }
+
+        GT_FUNCTION_DEVICE double fma(double x, double y, double z) { return ::fma(x, y, z); }
+#else
+        using std::fma;
+#endif
+
 #ifdef GT_CUDACC
         // providing the same overload pattern as the std library
         // auto return type to ensure that we do not accidentally cast
@@ -28,6 +28,23 @@ namespace gridtools {
         size_t m_counter = 0;
         Impl m_impl;
 
+        // optional customization points of the implementation: `reset_impl()` and `to_string_impl()`
+        template <class T>
+        static auto reset_impl(T &impl, int) -> decltype(impl.reset_impl()) {
+            impl.reset_impl();
+        }
+        template <class T>
+        static void reset_impl(T &, long) {}
+
+        template <class T>
+        static auto impl_string(T const &impl, int) -> decltype(impl.to_string_impl()) {
+            return impl.to_string_impl();
+        }
+        template <class T>
+        static std::string impl_string(T const &, long) {
+            return {};
+        }
+
       public:
         timer() = default;
         timer(std::string name) : m_name(std::move(name)) {}
@@ -38,6 +55,7 @@ namespace gridtools {
         void reset() {
             m_total_time = 0;
             m_counter = 0;
+            reset_impl(m_impl, 0);
         }
 
         /**
@@ -74,6 +92,9 @@ namespace gridtools {
                     << " (" << m_counter << "x called)";
             else
                 out << m_name << "\t[s]\t" << m_total_time << " (" << m_counter << "x called)";
+            auto impl_str = impl_string(m_impl, 0);
+            if (!impl_str.empty())
+                out << "\t" << impl_str;
             return out.str();
         }
     };
@@ -0,0 +1,205 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "../omp.hpp"
+
+/**
+ *  Wall time plus hardware counters, read with Linux `perf_event_open`.
+ *
+ *  The counters of every OpenMP thread are opened lazily by the thread itself (they count user space only, which
+ *  is allowed with the default `perf_event_paranoid` setting) and summed up on pause. Events that the kernel or the
+ *  hardware does not support are reported as `n/a`. Note that the counts include the spinning of idle OpenMP threads.
+ */
+namespace gridtools {
+    namespace timer_perf_impl_ {
+        enum event { cycles, instructions, llc_misses, llc_load_misses, llc_store_misses, num_events };
+
+        constexpr long long cache_line_size = 64;
+
+        inline perf_event_attr make_attr(event e) {
+            perf_event_attr res;
+            std::memset(&res, 0, sizeof(res));
+            res.size = sizeof(res);
+            res.disabled = 1;
+            res.exclude_kernel = 1;
+            res.exclude_hv = 1;
+            auto llc = [](unsigned long long op) {
+                return PERF_COUNT_HW_CACHE_LL | op << 8 | (unsigned long long)PERF_COUNT_HW_CACHE_RESULT_MISS << 16;
+            };
+            switch (e) {
+            case cycles:
+                res.type = PERF_TYPE_HARDWARE;
+                res.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case instructions:
+                res.type = PERF_TYPE_HARDWARE;
+                res.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case llc_misses:
+                res.type = PERF_TYPE_HARDWARE;
+                res.config = PERF_COUNT_HW_CACHE_MISSES;
+                break;
+            case llc_load_misses:
+                res.type = PERF_TYPE_HW_CACHE;
+                res.config = llc(PERF_COUNT_HW_CACHE_OP_READ);
+                break;
+            default:
+                res.type = PERF_TYPE_HW_CACHE;
+                res.config = llc(PERF_COUNT_HW_CACHE_OP_WRITE);
+            }
+            return res;
+        }
+
+        using values_t = std::array<long long, num_events>;
+
+        /*
+         *  The counters of the calling thread. A negative value means that the event is not available.
+         */
+        class thread_counters {
+            std::array<int, num_events> m_fds;
+
+          public:
+            thread_counters() {
+                for (int e = 0; e != num_events; ++e) {
+                    auto attr = make_attr(event(e));
+                    m_fds[e] = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+                }
+            }
+            thread_counters(thread_counters const &) = delete;
+            thread_counters &operator=(thread_counters const &) = delete;
+            ~thread_counters() {
+                for (int fd : m_fds)
+                    if (fd >= 0)
+                        close(fd);
+            }
+
+            void start() const {
+                for (int fd : m_fds)
+                    if (fd >= 0) {
+                        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+                    }
+            }
+
+            values_t stop() const {
+                values_t res;
+                for (int e = 0; e != num_events; ++e) {
+                    res[e] = -1;
+                    if (m_fds[e] < 0)
+                        continue;
+                    ioctl(m_fds[e], PERF_EVENT_IOC_DISABLE, 0);
+                    long long val;
+                    if (read(m_fds[e], &val, sizeof(val)) == sizeof(val))
+                        res[e] = val;
+                }
+                return res;
+            }
+        };
+
+        inline thread_counters const &this_thread_counters() {
+            thread_local thread_counters res;
+            return res;
+        }
+    } // namespace timer_perf_impl_
+
+    /**
+     * @class timer_perf
+     */
+    class timer_perf {
+        using values_t = timer_perf_impl_::values_t;
+
+        double m_start_time;
+        double m_total_time = 0;
+        values_t m_totals = {};
+        bool m_available[timer_perf_impl_::num_events] = {};
+        bool m_is_first = true;
+
+        std::string format(int e) const {
+            return m_available[e] ? std::to_string(m_totals[e]) : std::string("n/a");
+        }
+
+      public:
+        void start_impl() {
+#pragma omp parallel
+            timer_perf_impl_::this_thread_counters().start();
+            m_start_time = omp_get_wtime();
+        }
+
+        double pause_impl() {
+            using namespace timer_perf_impl_;
+            double res = omp_get_wtime() - m_start_time;
+            values_t sums = {};
+            bool available[num_events];
+            for (bool &val : available)
+                val = true;
+#pragma omp parallel
+            {
+                auto vals = this_thread_counters().stop();
+#pragma omp critical
+                for (int e = 0; e != num_events; ++e) {
+                    available[e] = available[e] && vals[e] >= 0;
+                    sums[e] += vals[e];
+                }
+            }
+            for (int e = 0; e != num_events; ++e) {
+                m_available[e] = (m_is_first || m_available[e]) && available[e];
+                m_totals[e] += sums[e];
+            }
+            m_is_first = false;
+            m_total_time += res;
+            return res;
+        }
+
+        void reset_impl() {
+            m_total_time = 0;
+            m_totals = {};
+            std::fill(std::begin(m_available), std::end(m_available), false);
+            m_is_first = true;
+        }
+
+        /**
+         *  @return the counter value accumulated over all pauses, or -1 if the event is not available
+         */
+        long long value(timer_perf_impl_::event e) const { return m_available[e] ? m_totals[e] : -1; }
+
+        /**
+         *  @return the counters and the derived metrics (IPC and the LLC traffic in GB/s) as string
+         */
+        std::string to_string_impl() const {
+            using namespace timer_perf_impl_;
+            std::ostringstream out;
+            out << "cycles " << format(cycles) << "\tinstructions " << format(instructions) << "\tIPC ";
+            if (m_available[cycles] && m_available[instructions] && m_totals[cycles] > 0)
+                out << (double)m_totals[instructions] / m_totals[cycles];
+            else
+                out << "n/a";
+            out << "\tLLC misses " << format(llc_misses) << "\tLLC traffic [GB/s] ";
+            if (m_available[llc_load_misses] && m_available[llc_store_misses] && m_total_time > 0)
+                out << (m_totals[llc_load_misses] + m_totals[llc_store_misses]) * cache_line_size / m_total_time /
+                           1e9;
+            else
+                out << "n/a";
+            return out.str();
+        }
+    };
+} // namespace gridtools
@@ -34,6 +34,18 @@ namespace gridtools {
                 MPI_Comm_rank(world(), &pid_holder());
                 MPI_Comm_size(world(), &procs_holder());
             }
+
+            inline void init(int *argc, char ***argv, int required) {
+                int ready;
+                MPI_Initialized(&ready);
+                if (!ready) {
+                    // the provided level can be lower, `progress_thread` checks it
+                    int provided;
+                    MPI_Init_thread(argc, argv, required, &provided);
+                }
+                MPI_Comm_rank(world(), &pid_holder());
+                MPI_Comm_size(world(), &procs_holder());
+            }
         } // namespace impl_
 
         inline int pid() { return impl_::pid_holder(); }
@@ -44,6 +56,13 @@ namespace gridtools {
 
         inline void init() { impl_::init(nullptr, nullptr); }
 
+        /**
+         * Initializes MPI with the requested thread support, e.g. `MPI_THREAD_MULTIPLE` for `progress_thread`.
+         */
+        inline void init(int argc, char **argv, int required) { impl_::init(&argc, &argv, required); }
+
+        inline void init(int required) { impl_::init(nullptr, nullptr, required); }
+
         inline void finalize() { MPI_Finalize(); }
     } // namespace gcl
 } // namespace gridtools
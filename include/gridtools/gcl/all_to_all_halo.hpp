@@ -106,6 +106,10 @@ namespace gridtools {
             /** This method waits for the data to arrive and be unpacked
              */
             void wait() { a2a.wait(); }
+
+            /** This method waits for the sends to complete, so that the sent data can be modified
+             */
+            void wait_sends() { a2a.wait_sends(); }
         };
     } // namespace gcl
 } // namespace gridtools
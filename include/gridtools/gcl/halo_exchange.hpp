@@ -9,10 +9,12 @@
  */
 #pragma once
 
+#include <type_traits>
 #include <vector>
 
 #include "../common/halo_descriptor.hpp"
 #include "../common/layout_map_metafunctions.hpp"
+#include "high_level/descriptor_dim_by_dim.hpp"
 #include "high_level/descriptor_generic_manual.hpp"
 #include "high_level/descriptors.hpp"
 #include "high_level/descriptors_manual_gpu.hpp"
@@ -20,6 +22,7 @@
 #include "low_level/Halo_Exchange_3D.hpp"
 #include "low_level/arch.hpp"
 #include "low_level/proc_grids_3D.hpp"
+#include "low_level/progress_thread.hpp"
 
 namespace gridtools {
     namespace gcl {
@@ -153,13 +156,15 @@ namespace gridtools {
            dimension in the processor grid \tparam DataType Value type the elements int the arrays \tparam DIMS Number
            of dimensions of data arrays (equal to the dimension of the processor grid) \tparam GCL_ARCH Specification of
            the "architecture", that is the place where the data to be exchanged is. Possible coiches are defined in
-           low_level/gcl_arch.h .
+           low_level/gcl_arch.h . \tparam Method Either gcl::all_neighbours to exchange with the 26 neighbours at
+           once, or gcl::dimension_by_dimension to exchange with the 6 face neighbours in 3 phases and forward the
+           edges and corners (see hndlr_dim_by_dim).
         */
         template <typename T_layout_map,
             typename layout2proc_map_abs,
             typename DataType,
             typename Gcl_Arch = cpu,
-            int version = 0>
+            typename Method = all_neighbours>
         class halo_exchange_dynamic_ut {
 
             typedef typename reverse_map<T_layout_map>::type layout_map; // This is necessary since the internals of gcl
@@ -178,10 +183,13 @@ namespace gridtools {
             /**
                Type of the Level 3 pattern used.
             */
-            typedef Halo_Exchange_3D<grid_type> pattern_type;
+            typedef Halo_Exchange_3D<grid_type, 1, std::is_same<Gcl_Arch, cpu>::value> pattern_type;
 
           private:
-            typedef hndlr_dynamic_ut<DataType, grid_type, pattern_type, layout2proc_map, Gcl_Arch> hd_t;
+            typedef std::conditional_t<std::is_same<Method, dimension_by_dimension>::value,
+                hndlr_dim_by_dim<DataType, grid_type, pattern_type, layout2proc_map, Gcl_Arch>,
+                hndlr_dynamic_ut<DataType, grid_type, pattern_type, layout2proc_map, Gcl_Arch>>
+                hd_t;
 
             hd_t hd;
 
@@ -216,6 +224,15 @@ namespace gridtools {
             */
             void setup(int max_fields_n) { hd.setup(max_fields_n); }
 
+            /**
+               Function to pass the messages to the neighbours on the same node through an MPI-3 shared memory window
+               instead of MPI point to point communication. Available for gcl::cpu, to be called after setup. It is
+               collective over the communicator of the pattern.
+
+               \param node The processes that exchange through shared memory, by default those on the same node
+            */
+            void enable_shared_memory(MPI_Comm node = MPI_COMM_NULL) { hd.enable_shared_memory(node); }
+
             /**
                Function to register halos with the pattern. The registration
                happens specifing the ordiring of the dimensions as the user
@@ -296,6 +313,18 @@ namespace gridtools {
             */
             void start_exchange() { hd.start_exchange(); }
 
+            /**
+               function to trigger data exchange initiation, where the data is received and unpacked into the fields by
+               a progress thread, while the caller continues. The halos of the fields are complete when wait() returns,
+               unpack() must not be called. Only available with gcl::cpu.
+
+               \param[in] progress The progress thread, MPI must be initialized with MPI_THREAD_MULTIPLE
+               \param[in] fields vector with data fields pointers to be unpacked into, as passed to pack()
+            */
+            void start_exchange(progress_thread &progress, std::vector<DataType *> const &fields) {
+                hd.start_exchange(progress, fields);
+            }
+
             /**
                function to trigger data exchange
 
@@ -347,7 +376,7 @@ namespace gridtools {
                Type of the Level 3 pattern used. This is available only if the pattern uses a Level 3 pattern.
                In the case the implementation is not using L3, the type is not available.
             */
-            typedef Halo_Exchange_3D<grid_type> pattern_type;
+            typedef Halo_Exchange_3D<grid_type, 1, std::is_same<Gcl_Arch, cpu>::value> pattern_type;
 
           private:
             hndlr_generic<pattern_type, layout2proc_map, Gcl_Arch> hd;
@@ -393,6 +422,15 @@ namespace gridtools {
                 hd.setup(max_fields_n, halo_example, typesize);
             }
 
+            /**
+               Function to pass the messages to the neighbours on the same node through an MPI-3 shared memory window
+               instead of MPI point to point communication. Available for gcl::cpu, to be called after setup. It is
+               collective over the communicator of the pattern.
+
+               \param node The processes that exchange through shared memory, by default those on the same node
+            */
+            void enable_shared_memory(MPI_Comm node = MPI_COMM_NULL) { hd.enable_shared_memory(node); }
+
             /**
                Function to pack data to be sent
 
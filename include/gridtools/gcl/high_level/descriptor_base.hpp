@@ -70,6 +70,12 @@ namespace gridtools {
             */
             void wait() { m_haloexch.wait(); }
 
+            /**
+               function to pass the messages to the neighbours on the same node through shared memory, see
+               Halo_Exchange_3D::enable_shared_memory. To be called after setup.
+            */
+            void enable_shared_memory(MPI_Comm node = MPI_COMM_NULL) { m_haloexch.enable_shared_memory(node); }
+
             /**
                Retrieve the pattern from which the computing grid and other information
                can be retrieved. The function is available only if the underlying
@@ -0,0 +1,173 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "../../common/array.hpp"
+#include "../../common/halo_descriptor.hpp"
+#include "../../common/make_array.hpp"
+#include "../low_level/arch.hpp"
+#include "descriptors.hpp"
+
+namespace gridtools {
+    namespace gcl {
+        /** The halos are exchanged with all 26 neighbours at once
+         */
+        struct all_neighbours {};
+
+        /** The halos are exchanged with the 2 neighbours along one dimension after the other. The messages along a
+            dimension contain the halos of the previous dimensions, so the edges and corners are forwarded through the
+            face neighbours: 6 messages in 3 phases instead of 26 messages
+         */
+        struct dimension_by_dimension {};
+
+        /** \class hndlr_dim_by_dim
+            Handler with the same interface as hndlr_dynamic_ut that exchanges the halos dimension by dimension.
+
+            Every phase is a hndlr_dynamic_ut whose halo descriptors have no halos in the other dimensions, so that
+            only the two face neighbours along the dimension of the phase get non empty messages. In the dimensions
+            of the previous phases the exchanged region extends into the halos that have been received from a
+            neighbour.
+
+            The first phase is performed by pack, exchange (or start_exchange and wait) and unpack, the remaining
+            phases are performed by unpack, since they have to read the halos unpacked by the previous phase.
+
+            \tparam DataType Type of the elements stored in the data fields
+            \tparam GridType The type of the processing grid used for data exchange
+            \tparam HaloExch Communication pattern with halo exchange
+            \tparam proc_layout Map between dimensions in increasing-stride order and processing grid dimensions
+            \tparam Gcl_Arch Specification of the "architecture", that is the place where the data to be exchanged is
+        */
+        template <typename DataType, typename GridType, typename HaloExch, typename proc_layout, typename Gcl_Arch>
+        class hndlr_dim_by_dim {
+            static_assert(std::is_same<Gcl_Arch, cpu>::value, "dimension by dimension exchange needs gcl::cpu");
+
+            static constexpr int DIMS = GridType::ndims;
+
+            typedef hndlr_dynamic_ut<DataType, GridType, HaloExch, proc_layout, Gcl_Arch> phase_type;
+
+            std::unique_ptr<phase_type> m_phases[DIMS];
+
+          public:
+            empty_field_no_dt halo;
+
+            typedef Gcl_Arch arch_type;
+            typedef typename phase_type::pattern_type pattern_type;
+            typedef typename phase_type::grid_type grid_type;
+
+            hndlr_dim_by_dim(typename grid_type::period_type const &c, MPI_Comm const &comm) {
+                for (auto &phase : m_phases)
+                    phase.reset(new phase_type(c, comm));
+            }
+
+            /**
+               Function to setup internal data structures for data exchange and preparing eventual underlying layers
+
+               \param max_fields_n Maximum number of data fields that will be passed to the communication functions
+            */
+            void setup(int max_fields_n) {
+                auto &&proc_grid = pattern().proc_grid();
+                auto has_neighbour = [&](int dim, int side) {
+                    auto eta = make_array(0, 0, 0);
+                    eta[dim] = side;
+                    const int ii_P = eta[proc_layout::at(0)];
+                    const int jj_P = eta[proc_layout::at(1)];
+                    const int kk_P = eta[proc_layout::at(2)];
+                    return proc_grid.proc(ii_P, jj_P, kk_P) != -1;
+                };
+                for (int phase = 0; phase < DIMS; ++phase) {
+                    for (int d = 0; d < DIMS; ++d) {
+                        halo_descriptor const &h = halo.halos[d];
+                        if (d == phase) {
+                            m_phases[phase]->halo.add_halo(d, h);
+                            continue;
+                        }
+                        int begin = h.begin();
+                        int end = h.end();
+                        if (d < phase && has_neighbour(d, -1))
+                            begin -= h.minus();
+                        if (d < phase && has_neighbour(d, 1))
+                            end += h.plus();
+                        m_phases[phase]->halo.add_halo(d, 0, 0, begin, end, h.total_length());
+                    }
+                    m_phases[phase]->setup(max_fields_n);
+                }
+            }
+
+            /**
+               Function to pack data to be sent
+
+               \param[in] _fields data fields to be packed
+            */
+            template <typename... FIELDS>
+            void pack(const FIELDS &... _fields) {
+                m_phases[0]->pack(_fields...);
+            }
+
+            /**
+               Function to unpack received data and to exchange the halos along the remaining dimensions
+
+               \param[in] _fields data fields where to unpack data
+            */
+            template <typename... FIELDS>
+            void unpack(const FIELDS &... _fields) {
+                m_phases[0]->unpack(_fields...);
+                for (int phase = 1; phase < DIMS; ++phase) {
+                    m_phases[phase]->pack(_fields...);
+                    m_phases[phase]->exchange();
+                    m_phases[phase]->unpack(_fields...);
+                }
+            }
+
+            /**
+               Function to pack data to be sent
+
+               \param[in] fields vector with data fields pointers to be packed from
+            */
+            void pack(std::vector<DataType *> const &fields) { m_phases[0]->pack(fields); }
+
+            /**
+               Function to unpack received data and to exchange the halos along the remaining dimensions
+
+               \param[in] fields vector with data fields pointers to be unpacked into
+            */
+            void unpack(std::vector<DataType *> const &fields) {
+                m_phases[0]->unpack(fields);
+                for (int phase = 1; phase < DIMS; ++phase) {
+                    m_phases[phase]->pack(fields);
+                    m_phases[phase]->exchange();
+                    m_phases[phase]->unpack(fields);
+                }
+            }
+
+            void exchange() { m_phases[0]->exchange(); }
+
+            void post_receives() { m_phases[0]->post_receives(); }
+
+            void do_sends() { m_phases[0]->do_sends(); }
+
+            void start_exchange() { m_phases[0]->start_exchange(); }
+
+            void wait() { m_phases[0]->wait(); }
+
+            void enable_shared_memory(MPI_Comm node = MPI_COMM_NULL) {
+                for (auto &phase : m_phases)
+                    phase->enable_shared_memory(node);
+            }
+
+            pattern_type const &pattern() const { return m_phases[0]->pattern(); }
+
+            grid_type const &comm() const { return m_phases[0]->comm(); }
+        };
+    } // namespace gcl
+} // namespace gridtools
@@ -478,6 +478,20 @@ namespace gridtools {
             */
             void unpack(std::vector<DataType *> const &fields) { unpack_vector_dims<DIMS, 0>()(*this, fields); }
 
+            /**
+               Function to start the data exchange, where the received data is unpacked by a progress thread as soon as
+               it arrives from a neighbour. The exchange is completed by wait().
+
+               \param[in] progress The progress thread
+               \param[in] fields vector with data fields pointers to be unpacked into
+            */
+            void start_exchange(progress_thread &progress, std::vector<DataType *> const &fields) {
+                base_type::m_haloexch.start_exchange(
+                    progress, [this, fields](int i_P, int j_P, int k_P) { unpack_from(i_P, j_P, k_P, fields); });
+            }
+
+            using base_type::start_exchange;
+
             /// Utilities
 
             /**
@@ -494,6 +508,23 @@ namespace gridtools {
             friend struct allocation_service<this_type>;
 
           private:
+            /*
+             * Unpacks the message from the neighbour with the given coordinates in the process grid.
+             */
+            void unpack_from(int i_P, int j_P, int k_P, std::vector<DataType *> const &fields) const {
+                for (int ii = -1; ii <= 1; ++ii)
+                    for (int jj = -1; jj <= 1; ++jj)
+                        for (int kk = -1; kk <= 1; ++kk) {
+                            auto eta = make_array(ii, jj, kk);
+                            if (eta[proc_layout::at(0)] != i_P || eta[proc_layout::at(1)] != j_P ||
+                                eta[proc_layout::at(2)] != k_P)
+                                continue;
+                            DataType *it = &(recv_buffer[translate()(ii, jj, kk)][0]);
+                            for (size_t i = 0; i < fields.size(); ++i)
+                                halo.unpack(eta, fields[i], it);
+                        }
+            }
+
             template <int I, int dummy>
             struct pack_dims {};
 
@@ -0,0 +1,342 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include "../common/array.hpp"
+#include "../common/halo_descriptor.hpp"
+#include "all_to_all_halo.hpp"
+
+/** \file
+
+    Measurement driven load balancing of distributed 3D fields.
+
+    The global domain is split along the first two dimensions of the process grid into blocks of possibly different
+    sizes: every process row along the first dimension has the same extent in the first dimension, and every process
+    column along the second dimension has the same extent in the second dimension (a rectilinear partition). The
+    third dimension is not rebalanced.
+
+    The ranks report the time they spent on their blocks. The time of a block is assumed to be spread uniformly over
+    its points, the costs of the points are summed along the other dimension and every dimension is split so that the
+    parts have the same cost. After a new partition has been computed, the fields are reallocated with the new local
+    sizes by the user, their data is migrated with `all_to_all_halo` and the halo exchange patterns are rebuilt
+    with the new halo descriptors.
+ */
+namespace gridtools {
+    namespace gcl {
+        namespace load_balancer_impl_ {
+            inline std::vector<int> uniform_bounds(int size, int parts) {
+                std::vector<int> res(parts + 1);
+                for (int p = 0; p <= parts; ++p)
+                    res[p] = int(long(size) * p / parts);
+                return res;
+            }
+
+            /*
+             * The bounds of `parts` parts of nearly equal cost, every part at least `min_size` long.
+             */
+            inline std::vector<int> split(std::vector<double> const &costs, int parts, int min_size) {
+                int size = costs.size();
+                if (size < parts * min_size)
+                    throw std::runtime_error("load_balancer: the domain is too small for the minimum block size");
+                std::vector<double> prefix(size + 1, 0);
+                std::partial_sum(costs.begin(), costs.end(), prefix.begin() + 1);
+                std::vector<int> res(parts + 1);
+                res[0] = 0;
+                res[parts] = size;
+                for (int p = 1; p < parts; ++p) {
+                    double target = prefix[size] * p / parts;
+                    int x = std::lower_bound(prefix.begin(), prefix.end(), target) - prefix.begin();
+                    if (x > 0 && target - prefix[x - 1] < prefix[x] - target)
+                        --x;
+                    res[p] = std::min(std::max(x, res[p - 1] + min_size), size - (parts - p) * min_size);
+                }
+                return res;
+            }
+
+            inline halo_descriptor sub_block(halo_descriptor const &local, int first, int last) {
+                return halo_descriptor(0, 0, local.begin() + first, local.begin() + last - 1, local.total_length());
+            }
+        } // namespace load_balancer_impl_
+
+        /** Rectilinear partition of the first two dimensions of a global domain: the bounds of the blocks of the
+            processes along every dimension.
+         */
+        class rectilinear_partition {
+            std::vector<int> m_bounds[2];
+
+          public:
+            /** Uniform partition of `global_sizes` over `procs` processes
+             */
+            rectilinear_partition(array<int, 2> const &global_sizes, array<int, 2> const &procs) {
+                for (int d = 0; d < 2; ++d)
+                    m_bounds[d] = load_balancer_impl_::uniform_bounds(global_sizes[d], procs[d]);
+            }
+
+            /** Partition with the given bounds: the first bound is 0, the last one is the global size
+             */
+            rectilinear_partition(std::vector<int> bounds0, std::vector<int> bounds1)
+                : m_bounds{std::move(bounds0), std::move(bounds1)} {}
+
+            std::vector<int> const &bounds(int dim) const { return m_bounds[dim]; }
+
+            int parts(int dim) const { return m_bounds[dim].size() - 1; }
+
+            int global_size(int dim) const { return m_bounds[dim].back(); }
+
+            /** Global index of the first point of the block of the processes with coordinate `coord` along `dim`
+             */
+            int begin(int dim, int coord) const { return m_bounds[dim][coord]; }
+
+            int end(int dim, int coord) const { return m_bounds[dim][coord + 1]; }
+
+            int size(int dim, int coord) const { return end(dim, coord) - begin(dim, coord); }
+
+            bool operator==(rectilinear_partition const &other) const {
+                return m_bounds[0] == other.m_bounds[0] && m_bounds[1] == other.m_bounds[1];
+            }
+
+            bool operator!=(rectilinear_partition const &other) const { return !(*this == other); }
+        };
+
+        /** Computes the partition that balances the times measured on `partition`. Collective over the communicator
+            of the process grid.
+
+            \param g The process grid
+            \param partition The partition on which the times have been measured
+            \param time The time spent by this rank on its block
+            \param min_size The minimum extent of a block, usually the width of the halos
+         */
+        template <typename pgrid>
+        rectilinear_partition rebalance(
+            pgrid const &g, rectilinear_partition const &partition, double time, int min_size = 1) {
+            MPI_Comm comm = g.communicator();
+            int size;
+            MPI_Comm_size(comm, &size);
+            std::vector<double> times(size);
+            MPI_Allgather(&time, 1, MPI_DOUBLE, times.data(), 1, MPI_DOUBLE, comm);
+
+            int parts[2] = {partition.parts(0), partition.parts(1)};
+            // the cost of a point of every block, the blocks along the third dimension are added together
+            std::vector<double> density(parts[0] * parts[1], 0);
+            for (int rank = 0; rank != size; ++rank) {
+                int coords[3];
+                MPI_Cart_coords(comm, rank, 3, coords);
+                density[coords[0] * parts[1] + coords[1]] +=
+                    times[rank] / (double(partition.size(0, coords[0])) * partition.size(1, coords[1]));
+            }
+
+            std::vector<int> bounds[2];
+            for (int d = 0; d < 2; ++d) {
+                std::vector<double> costs(partition.global_size(d));
+                for (int p = 0; p < parts[d]; ++p) {
+                    double cost = 0;
+                    for (int q = 0; q < parts[1 - d]; ++q)
+                        cost += (d == 0 ? density[p * parts[1] + q] : density[q * parts[1] + p]) *
+                                partition.size(1 - d, q);
+                    std::fill(costs.begin() + partition.begin(d, p), costs.begin() + partition.end(d, p), cost);
+                }
+                bounds[d] = load_balancer_impl_::split(costs, parts[d], min_size);
+            }
+            return {std::move(bounds[0]), std::move(bounds[1])};
+        }
+
+        /** Moves the data of a field from the blocks of one partition to the blocks of another one. Collective over
+            the communicator of the process grid.
+
+            Every rank sends the intersection of its block in `from` with the block of every other rank in `to`, in
+            the same layer along the third dimension. Only the interior of the fields is moved, the halos of `dst`
+            have to be exchanged afterwards.
+
+            \param g The process grid
+            \param from The partition of `src`
+            \param src The local field, distributed according to `from`
+            \param src_local Halo descriptors of `src` (decreasing strides)
+            \param to The partition of `dst`
+            \param dst The local field, distributed according to `to`
+            \param dst_local Halo descriptors of `dst` (decreasing strides)
+         */
+        template <typename vtype, typename pgrid>
+        void migrate(pgrid const &g,
+            rectilinear_partition const &from,
+            vtype const *src,
+            array<halo_descriptor, 3> const &src_local,
+            rectilinear_partition const &to,
+            vtype *dst,
+            array<halo_descriptor, 3> const &dst_local) {
+            using load_balancer_impl_::sub_block;
+            int pi, pj, pk, PI, PJ, PK;
+            g.coords(pi, pj, pk);
+            g.dims(PI, PJ, PK);
+
+            // the range, relative to the block at `coords` in `outer`, that lies in the block at `other` in `inner`
+            auto intersect = [](array<int, 2> const &coords,
+                                 rectilinear_partition const &outer,
+                                 array<int, 2> const &other,
+                                 rectilinear_partition const &inner,
+                                 array<std::pair<int, int>, 2> &res) {
+                for (int d = 0; d < 2; ++d) {
+                    int first = std::max(outer.begin(d, coords[d]), inner.begin(d, other[d]));
+                    int last = std::min(outer.end(d, coords[d]), inner.end(d, other[d]));
+                    if (first >= last)
+                        return false;
+                    res[d] = {first - outer.begin(d, coords[d]), last - outer.begin(d, coords[d])};
+                }
+                return true;
+            };
+
+            all_to_all_halo<vtype, pgrid> a2a(g, g.communicator());
+            array<int, 2> mine = {pi, pj};
+            for (int qi = 0; qi < PI; ++qi)
+                for (int qj = 0; qj < PJ; ++qj) {
+                    array<int, 2> other = {qi, qj};
+                    array<int, 3> crds = {qi, qj, pk};
+                    array<std::pair<int, int>, 2> range;
+                    if (intersect(mine, from, other, to, range))
+                        a2a.register_block_to(const_cast<vtype *>(src),
+                            array<halo_descriptor, 3>{sub_block(src_local[0], range[0].first, range[0].second),
+                                sub_block(src_local[1], range[1].first, range[1].second),
+                                sub_block(src_local[2], 0, src_local[2].end() - src_local[2].begin() + 1)},
+                            crds);
+                    if (intersect(mine, to, other, from, range))
+                        a2a.register_block_from(dst,
+                            array<halo_descriptor, 3>{sub_block(dst_local[0], range[0].first, range[0].second),
+                                sub_block(dst_local[1], range[1].first, range[1].second),
+                                sub_block(dst_local[2], 0, dst_local[2].end() - dst_local[2].begin() + 1)},
+                            crds);
+                }
+            a2a.setup();
+            a2a.start_exchange();
+            a2a.wait();
+            a2a.wait_sends();
+        }
+
+        /** Triggers the rebalancing of a rectilinear partition every few steps.
+
+            \tparam pgrid Type of the 3D process grid
+
+            Example:
+
+            load_balancer<MPI_3D_process_grid_t<3>> balancer(pgrid, {ni, nj}, 50, 1.1, halo);
+            for (int step = 0; step < n; ++step) {
+                double time = compute(field);
+                if (balancer.step(time)) {
+                    // allocate new_field with the local sizes of balancer.partition()
+                    balancer.migrate(field.data(), halos, new_field.data(), new_halos);
+                    // rebuild the halo exchange pattern with new_halos
+                }
+            }
+         */
+        template <typename pgrid>
+        class load_balancer {
+          public:
+            typedef pgrid grid_type;
+            typedef array<halo_descriptor, 3> halo_block;
+
+          private:
+            grid_type const &m_grid;
+            int m_period;
+            double m_tolerance;
+            int m_min_size;
+            rectilinear_partition m_partition;
+            rectilinear_partition m_previous;
+            int m_steps = 0;
+            double m_time = 0;
+
+            static array<int, 2> procs(grid_type const &g) {
+                int PI, PJ, PK;
+                g.dims(PI, PJ, PK);
+                return {PI, PJ};
+            }
+
+          public:
+            /** Constructor. Starts with a uniform partition.
+
+                \param g The process grid, it has to outlive the load balancer
+                \param global_sizes The global sizes of the first two dimensions
+                \param period The number of steps between two rebalancings
+                \param tolerance The partition changes only if the maximum time exceeds the mean time by this factor
+                \param min_size The minimum extent of a block, usually the width of the halos
+             */
+            load_balancer(grid_type const &g,
+                array<int, 2> const &global_sizes,
+                int period,
+                double tolerance = 1.1,
+                int min_size = 1)
+                : m_grid(g), m_period(period), m_tolerance(tolerance), m_min_size(min_size),
+                  m_partition(global_sizes, procs(g)), m_previous(m_partition) {
+                if (period < 1)
+                    throw std::runtime_error("load_balancer: the period should be positive");
+            }
+
+            /** Records the time of a step. Every `period` steps the partition is rebalanced, if the times are
+                unbalanced beyond the tolerance. Collective over the communicator of the process grid every
+                `period` steps.
+
+                \return true if the partition has changed, the fields have to be migrated then
+             */
+            bool step(double time) {
+                m_time += time;
+                if (++m_steps % m_period)
+                    return false;
+                double time_sum, time_max;
+                MPI_Allreduce(&m_time, &time_sum, 1, MPI_DOUBLE, MPI_SUM, m_grid.communicator());
+                MPI_Allreduce(&m_time, &time_max, 1, MPI_DOUBLE, MPI_MAX, m_grid.communicator());
+                int size;
+                MPI_Comm_size(m_grid.communicator(), &size);
+                bool unbalanced = time_max * size > m_tolerance * time_sum;
+                auto partition =
+                    unbalanced ? rebalance(m_grid, m_partition, m_time, m_min_size) : m_partition;
+                m_time = 0;
+                m_previous = std::move(m_partition);
+                m_partition = std::move(partition);
+                return m_partition != m_previous;
+            }
+
+            /** The current partition
+             */
+            rectilinear_partition const &partition() const { return m_partition; }
+
+            /** The partition before the last rebalancing
+             */
+            rectilinear_partition const &previous() const { return m_previous; }
+
+            /** Global index of the first point of the block of this rank along the first or the second dimension
+             */
+            int begin(int dim) const {
+                int coords[3];
+                m_grid.coords(coords[0], coords[1], coords[2]);
+                return m_partition.begin(dim, coords[dim]);
+            }
+
+            /** Size of the block of this rank along the first or the second dimension
+             */
+            int size(int dim) const {
+                int coords[3];
+                m_grid.coords(coords[0], coords[1], coords[2]);
+                return m_partition.size(dim, coords[dim]);
+            }
+
+            /** Moves a field from the previous partition to the current one, see `gcl::migrate`.
+             */
+            template <typename vtype>
+            void migrate(vtype const *src, halo_block const &src_local, vtype *dst, halo_block const &dst_local) const {
+                gcl::migrate(m_grid, m_previous, src, src_local, m_partition, dst, dst_local);
+            }
+        };
+    } // namespace gcl
+} // namespace gridtools
@@ -190,6 +190,18 @@ namespace gridtools {
                     }
                 }
             }
+
+            /** This function waits for the completion of the sends issued by
+                do_sends(), after which the sent data can be modified.
+             */
+            void wait_sends() {
+                MPI_Status status;
+                for (unsigned int i = 0; i < to.size(); ++i) {
+                    if (to[i].full()) {
+                        MPI_Wait(&(to[i].send_r), &status);
+                    }
+                }
+            }
         };
     } // namespace gcl
 } // namespace gridtools
@@ -9,8 +9,15 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "../../common/defs.hpp"
 #include "../GCL.hpp"
+#include "progress_thread.hpp"
+#include "shared_memory_channels.hpp"
 #include "translate.hpp"
 
 /** \file
@@ -83,6 +90,8 @@ namespace gridtools {
          * \n
          * \tparam PROC_GRID Processor Grid type. An object of this type will be passed to constructor.
          * \tparam ALIGN integer parameter that specify the alignment of the data to used. UNUSED IN CURRENT VERSION
+         * \tparam SHARED_MEMORY if true, the messages to the neighbours on the same node can be passed through an
+         * MPI-3 shared memory window (see enable_shared_memory), the buffers must be in host memory then
          * \n\n\n
          * Pattern for regular cyclic and acyclic halo exchange pattern in 3D
          * The communicating processes are arganized in a 3D grid. Given a process, neighbors processes
@@ -141,7 +150,7 @@ namespace gridtools {
            A running example can be found in the included example.
            \include test_halo_exchange_3D_all.cpp
         */
-        template <typename PROC_GRID, int ALIGN = 1>
+        template <typename PROC_GRID, int ALIGN = 1, bool SHARED_MEMORY = false>
         class Halo_Exchange_3D {
 
             typedef translate_t<3, typename default_layout_map<3>::type> translate;
@@ -245,9 +254,15 @@ namespace gridtools {
 
             const PROC_GRID /*&*/ m_proc_grid;
 
+            std::unique_ptr<shared_memory_channels> m_shared;
+
+            progress_thread *m_progress = nullptr;
+
+            bool is_local(int I, int J, int K) const { return m_shared && m_shared->is_local(translate()(I, J, K)); }
+
             template <int I, int J, int K>
             void post_receive() {
-                if (m_recv_buffers.size(I, J, K)) {
+                if (m_recv_buffers.size(I, J, K) && !is_local(I, J, K)) {
                     MPI_Irecv(static_cast<char *>(m_recv_buffers.buffer(I, J, K)),
                         m_recv_buffers.size(I, J, K),
                         MPI_CHAR,
@@ -260,7 +275,7 @@ namespace gridtools {
 
             template <int I, int J, int K>
             void perform_isend() {
-                if (m_send_buffers.size(I, J, K)) {
+                if (m_send_buffers.size(I, J, K) && !is_local(I, J, K)) {
                     MPI_Isend(static_cast<char *>(m_send_buffers.buffer(I, J, K)),
                         m_send_buffers.size(I, J, K),
                         MPI_CHAR,
@@ -286,12 +301,47 @@ namespace gridtools {
 
             template <int I, int J, int K>
             void wait() {
-                if (m_recv_buffers.size(I, J, K)) {
+                if (m_recv_buffers.size(I, J, K) && !is_local(I, J, K)) {
                     MPI_Status status;
                     MPI_Wait(&request(-I, -J, -K), &status);
                 }
             }
 
+            size_t max_local_send_size() const {
+                size_t res = 0;
+                for (int i = -1; i <= 1; ++i)
+                    for (int j = -1; j <= 1; ++j)
+                        for (int k = -1; k <= 1; ++k)
+                            if (is_local(i, j, k))
+                                res = std::max(res, (size_t)m_send_buffers.size(i, j, k));
+                return res;
+            }
+
+            void send_shared() {
+                m_shared->start(max_local_send_size());
+                for (int i = -1; i <= 1; ++i)
+                    for (int j = -1; j <= 1; ++j)
+                        for (int k = -1; k <= 1; ++k)
+                            if (is_local(i, j, k) && m_send_buffers.size(i, j, k))
+                                m_shared->send(translate()(i, j, k),
+                                    m_send_buffers.buffer(i, j, k),
+                                    m_send_buffers.size(i, j, k));
+            }
+
+            template <class OnReceive>
+            void receive_shared(OnReceive const &on_receive) {
+                for (int i = -1; i <= 1; ++i)
+                    for (int j = -1; j <= 1; ++j)
+                        for (int k = -1; k <= 1; ++k)
+                            if (is_local(i, j, k) && m_recv_buffers.size(i, j, k)) {
+                                m_shared->receive(translate()(i, j, k),
+                                    translate()(-i, -j, -k),
+                                    m_recv_buffers.buffer(i, j, k),
+                                    m_recv_buffers.size(i, j, k));
+                                on_receive(i, j, k);
+                            }
+            }
+
           public:
             /** Type of the processor grid used by the pattern
              */
@@ -308,6 +358,28 @@ namespace gridtools {
             explicit Halo_Exchange_3D(PROC_GRID /*const&*/ _pg)
                 : m_send_buffers(), m_recv_buffers(), request(), send_request(), m_proc_grid(_pg) {}
 
+            /** From now on the messages to the neighbours in `node` are passed through an MPI-3 shared memory window
+                instead of MPI point to point communication, the other messages are sent as before. The processes of
+                `node` have to be able to share memory, `MPI_COMM_NULL` stands for the processes on the same node;
+                only the first call chooses them.
+
+                The window is sized for the largest registered send buffer of the processes of `node`, thus it has
+                to be called after the buffers are registered and again after registering larger buffers. It is
+                collective over the communicator of the process grid; the exchanges that follow are not collective.
+            */
+            void enable_shared_memory(MPI_Comm node = MPI_COMM_NULL) {
+                static_assert(SHARED_MEMORY, "the pattern doesn't support exchanges through shared memory");
+                if (!m_shared) {
+                    int ranks[27];
+                    for (int i = -1; i <= 1; ++i)
+                        for (int j = -1; j <= 1; ++j)
+                            for (int k = -1; k <= 1; ++k)
+                                ranks[translate()(i, j, k)] = m_proc_grid.proc(i, j, k);
+                    m_shared = std::make_unique<shared_memory_channels>(m_proc_grid.communicator(), node, ranks);
+                }
+                m_shared->reserve(max_local_send_size());
+            }
+
             /** Function to retrieve the grid from the pattern, from which user can query
                 location information.
 
@@ -782,6 +854,11 @@ namespace gridtools {
                 if (m_proc_grid.template proc<0, 0, 1>() != -1) {
                     perform_isend<0, 0, 1>();
                 }
+
+                /* Publishing data to the neighbours on the same node while the messages are in flight
+                 */
+                if (m_shared)
+                    send_shared();
             }
 
             /** When called this function initiate the data exchabge. When the
@@ -812,7 +889,60 @@ namespace gridtools {
                 do_sends();
             }
 
+            /** When called this function initiates the data exchange and
+                hands the outstanding operations over to a progress thread,
+                which calls `on_receive(i, j, k)` as soon as the data from the
+                neighbour (i, j, k) is in its receive buffer. The calls are
+                made on the progress thread. The exchange is completed by
+                wait().
+             */
+            template <class OnReceive>
+            void start_exchange(progress_thread &progress, OnReceive on_receive) {
+                post_receives();
+                do_sends();
+                // the direction of the sending neighbour of each request, (0, 0, 0) for the sends
+                struct direction {
+                    int i, j, k;
+                };
+                std::vector<MPI_Request> requests;
+                std::vector<direction> directions;
+                for (int i = -1; i <= 1; ++i)
+                    for (int j = -1; j <= 1; ++j)
+                        for (int k = -1; k <= 1; ++k) {
+                            if ((i || j || k) && m_proc_grid.proc(i, j, k) != -1 && m_recv_buffers.size(i, j, k) &&
+                                !is_local(i, j, k)) {
+                                requests.push_back(request(-i, -j, -k));
+                                directions.push_back({i, j, k});
+                            }
+                            if (send_request.marked(i, j, k)) {
+                                requests.push_back(send_request(i, j, k));
+                                directions.push_back({0, 0, 0});
+                                send_request.reset(i, j, k);
+                            }
+                        }
+                m_progress = &progress;
+                progress.start(
+                    [this, on_receive] {
+                        if (m_shared)
+                            receive_shared(on_receive);
+                    },
+                    std::move(requests),
+                    [directions = std::move(directions), on_receive](int n) {
+                        auto &&d = directions[n];
+                        if (d.i || d.j || d.k)
+                            on_receive(d.i, d.j, d.k);
+                    });
+            }
+
             void wait() {
+                if (m_progress) {
+                    m_progress->wait();
+                    m_progress = nullptr;
+                    return;
+                }
+
+                if (m_shared)
+                    receive_shared([](int, int, int) {});
 
                 wait_for_sends();
 
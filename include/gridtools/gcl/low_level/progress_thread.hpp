@@ -0,0 +1,116 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+namespace gridtools {
+    namespace gcl {
+        /**
+         * A thread that completes non-blocking MPI operations in the background, so that they progress while the
+         * calling thread computes. MPI has to be initialized with `MPI_THREAD_MULTIPLE`, see `gcl::init`.
+         *
+         * The thread runs one job at a time: a task, followed by the polling of a list of requests with
+         * `MPI_Testsome`. A callback is invoked on the thread for every completed request, with its index in the
+         * list.
+         */
+        class progress_thread {
+            std::mutex m_mutex;
+            std::condition_variable m_cv;
+            bool m_busy = false;
+            bool m_stop = false;
+            std::function<void()> m_task;
+            std::vector<MPI_Request> m_requests;
+            std::function<void(int)> m_on_complete;
+            std::thread m_thread;
+
+            void poll() {
+                std::vector<int> indices(m_requests.size());
+                while (true) {
+                    int count;
+                    MPI_Testsome(m_requests.size(), m_requests.data(), &count, indices.data(), MPI_STATUSES_IGNORE);
+                    if (count == MPI_UNDEFINED)
+                        return;
+                    for (int i = 0; i != count; ++i)
+                        m_on_complete(indices[i]);
+                    if (!count)
+                        std::this_thread::yield();
+                }
+            }
+
+            void run() {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                while (true) {
+                    m_cv.wait(lock, [&] { return m_busy || m_stop; });
+                    if (m_stop)
+                        return;
+                    lock.unlock();
+                    m_task();
+                    poll();
+                    lock.lock();
+                    m_busy = false;
+                    m_cv.notify_all();
+                }
+            }
+
+          public:
+            progress_thread() {
+                int provided;
+                MPI_Query_thread(&provided);
+                if (provided < MPI_THREAD_MULTIPLE)
+                    throw std::runtime_error("the progress thread needs MPI initialized with MPI_THREAD_MULTIPLE");
+                m_thread = std::thread([this] { run(); });
+            }
+
+            progress_thread(progress_thread const &) = delete;
+            progress_thread &operator=(progress_thread const &) = delete;
+
+            ~progress_thread() {
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_cv.wait(lock, [&] { return !m_busy; });
+                    m_stop = true;
+                }
+                m_cv.notify_all();
+                m_thread.join();
+            }
+
+            /**
+             * Starts a job, after the previous one has completed. The thread owns the requests from now on.
+             */
+            void start(
+                std::function<void()> task, std::vector<MPI_Request> requests, std::function<void(int)> on_complete) {
+                wait();
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_task = std::move(task);
+                    m_requests = std::move(requests);
+                    m_on_complete = std::move(on_complete);
+                    m_busy = true;
+                }
+                m_cv.notify_all();
+            }
+
+            /** Waits until the current job, if any, has completed. */
+            void wait() {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [&] { return !m_busy; });
+            }
+        };
+    } // namespace gcl
+} // namespace gridtools
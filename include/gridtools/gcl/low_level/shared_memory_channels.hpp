@@ -0,0 +1,176 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#include <mpi.h>
+
+namespace gridtools {
+    namespace gcl {
+        /**
+         * Messages between the neighbours of a process grid that run on the same node. They are passed through an
+         * MPI-3 shared memory window instead of MPI point to point communication.
+         *
+         * Every process owns a segment of the window with one slot per neighbour direction. The sender copies a
+         * message into its slot and publishes it by raising the `ready` counter of the slot to the number of the
+         * exchange; the receiver copies the message out of the slot of the sender and acknowledges it by raising the
+         * `done` counter. A slot is written again only after the previous message has been acknowledged. Sender and
+         * receiver agree on the number of the exchange because both count the exchanges of the pattern.
+         *
+         * The window is sized by `reserve` when the pattern is set up, the exchanges themselves are not collective.
+         */
+        class shared_memory_channels {
+            struct alignas(64) slot_header {
+                std::atomic<long> ready;
+                std::atomic<long> done;
+            };
+            static_assert(ATOMIC_LONG_LOCK_FREE == 2, "lock free atomics are needed in shared memory");
+
+            static constexpr int directions = 27;
+
+            MPI_Comm m_node_comm = MPI_COMM_NULL;
+            MPI_Win m_win = MPI_WIN_NULL;
+            size_t m_capacity = 0;
+            long m_exchange = 0;
+            int m_node_ranks[directions];
+            char *m_own = nullptr;
+            char *m_segments[directions] = {};
+
+            size_t slot_size() const { return sizeof(slot_header) + m_capacity; }
+
+            slot_header &header(char *segment, int direction) const {
+                return *reinterpret_cast<slot_header *>(segment + direction * slot_size());
+            }
+
+            static char *payload(slot_header &header) { return reinterpret_cast<char *>(&header + 1); }
+
+            template <class Pred>
+            static void spin_until(Pred const &pred) {
+                while (!pred())
+                    std::this_thread::yield();
+            }
+
+            void free_window() {
+                if (m_win == MPI_WIN_NULL)
+                    return;
+                MPI_Win_unlock_all(m_win);
+                MPI_Win_free(&m_win);
+            }
+
+          public:
+            /**
+             * Collective over `comm`. `ranks[d]` is the rank in `comm` of the neighbour in the direction `d` or
+             * `-1` if there is none. The messages are passed through shared memory between the processes of `node`,
+             * which have to be able to share memory; `MPI_COMM_NULL` stands for the processes on the same node.
+             * The window is allocated by `reserve`.
+             */
+            shared_memory_channels(MPI_Comm comm, MPI_Comm node, int const (&ranks)[directions]) {
+                if (node == MPI_COMM_NULL)
+                    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &m_node_comm);
+                else
+                    MPI_Comm_dup(node, &m_node_comm);
+                MPI_Group group, node_group;
+                MPI_Comm_group(comm, &group);
+                MPI_Comm_group(m_node_comm, &node_group);
+                for (int d = 0; d != directions; ++d) {
+                    m_node_ranks[d] = MPI_UNDEFINED;
+                    if (ranks[d] >= 0)
+                        MPI_Group_translate_ranks(group, 1, &ranks[d], node_group, &m_node_ranks[d]);
+                }
+                MPI_Group_free(&node_group);
+                MPI_Group_free(&group);
+            }
+
+            shared_memory_channels(shared_memory_channels const &) = delete;
+            shared_memory_channels &operator=(shared_memory_channels const &) = delete;
+
+            ~shared_memory_channels() {
+                int finalized;
+                MPI_Finalized(&finalized);
+                if (finalized)
+                    return;
+                free_window();
+                MPI_Comm_free(&m_node_comm);
+            }
+
+            /** Whether the neighbour in the direction `d` exchanges through shared memory. */
+            bool is_local(int d) const { return m_node_ranks[d] != MPI_UNDEFINED; }
+
+            /**
+             * Makes room for messages of up to `bytes` bytes. Collective over the processes of `node`, which may
+             * pass different sizes. The window is reallocated only if the largest size of the node exceeds the
+             * capacity; then no message is pending, as every process has completed its previous exchanges.
+             */
+            void reserve(size_t bytes) {
+                unsigned long needed = bytes, capacity;
+                MPI_Allreduce(&needed, &capacity, 1, MPI_UNSIGNED_LONG, MPI_MAX, m_node_comm);
+                if (capacity <= m_capacity && m_win != MPI_WIN_NULL)
+                    return;
+                free_window();
+                m_capacity = (capacity + alignof(slot_header) - 1) / alignof(slot_header) * alignof(slot_header);
+                MPI_Info info;
+                MPI_Info_create(&info);
+                // every segment stays in the memory of its owner
+                MPI_Info_set(info, "alloc_shared_noncontig", "true");
+                MPI_Win_allocate_shared(directions * slot_size(), 1, info, m_node_comm, &m_own, &m_win);
+                MPI_Info_free(&info);
+                for (int d = 0; d != directions; ++d)
+                    new (&header(m_own, d)) slot_header{{0}, {0}};
+                MPI_Win_lock_all(MPI_MODE_NOCHECK, m_win);
+                MPI_Barrier(m_node_comm);
+                for (int d = 0; d != directions; ++d) {
+                    if (m_node_ranks[d] == MPI_UNDEFINED)
+                        continue;
+                    MPI_Aint size;
+                    int disp_unit;
+                    MPI_Win_shared_query(m_win, m_node_ranks[d], &size, &disp_unit, &m_segments[d]);
+                }
+                m_exchange = 0;
+            }
+
+            /** Starts the next exchange, where no message is larger than `bytes`. */
+            void start(size_t bytes) {
+                if (m_win == MPI_WIN_NULL || bytes > m_capacity)
+                    throw std::runtime_error("a halo message exceeds the shared memory window, enable the shared "
+                                             "memory exchange again after registering larger buffers");
+                ++m_exchange;
+            }
+
+            /** Publishes the message for the neighbour in the direction `d`. */
+            void send(int d, char const *data, size_t size) {
+                auto &slot = header(m_own, d);
+                spin_until([&] {
+                    return slot.done.load(std::memory_order_acquire) == slot.ready.load(std::memory_order_relaxed);
+                });
+                std::memcpy(payload(slot), data, size);
+                MPI_Win_sync(m_win);
+                slot.ready.store(m_exchange, std::memory_order_release);
+            }
+
+            /**
+             * Copies the message of the neighbour in the direction `d`, which the neighbour has sent in the
+             * direction `opposite`.
+             */
+            void receive(int d, int opposite, char *data, size_t size) {
+                auto &slot = header(m_segments[d], opposite);
+                spin_until([&] { return slot.ready.load(std::memory_order_acquire) == m_exchange; });
+                MPI_Win_sync(m_win);
+                std::memcpy(data, payload(slot), size);
+                slot.done.store(m_exchange, std::memory_order_release);
+            }
+        };
+    } // namespace gcl
+} // namespace gridtools
@@ -0,0 +1,348 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+
+#include "../common/array.hpp"
+#include "../common/halo_descriptor.hpp"
+#include "all_to_all_halo.hpp"
+
+/** \file
+
+    Streaming output of distributed 3D fields.
+
+    Every `ranks_per_aggregator` consecutive ranks of the process grid form a group; the first rank of the group is
+    its aggregator. On `write` each rank copies the interior of its local field into a send buffer and posts the send
+    to its aggregator using `all_to_all_halo`; it can modify the field right after the call returns. The aggregator
+    completes the gather of a step on the next `write` (or on `flush`) and writes it to a file on a background
+    thread, so the gather of step `n + 1` overlaps with the writing of step `n`. Two buffers are used in turn on all
+    ranks; a buffer is reused only after its previous send and file write have completed.
+
+    Every aggregator writes one file per step (see `file_name`) in the following native endian binary format:
+
+        char     magic[8]          "GTSTRM01"
+        uint32   value_size        sizeof(value_type)
+        uint32   ndims             3
+        int32    global_sizes[3]   decreasing strides
+        uint32   num_blocks
+        int32    blocks[num_blocks][6]  global begin and sizes of every block, decreasing strides
+        data                       the blocks one after another, C order
+
+    `read_output_file` reads such a file back.
+ */
+namespace gridtools {
+    namespace gcl {
+        namespace streaming_output_impl_ {
+            constexpr char magic[8] = {'G', 'T', 'S', 'T', 'R', 'M', '0', '1'};
+
+            struct block_info {
+                array<int, 3> begin;
+                array<int, 3> sizes;
+            };
+
+            inline size_t volume(array<int, 3> const &sizes) { return size_t(sizes[0]) * sizes[1] * sizes[2]; }
+
+            template <class T>
+            void write_raw(std::ofstream &file, T const *src, size_t n) {
+                file.write(reinterpret_cast<char const *>(src), n * sizeof(T));
+            }
+
+            template <class T>
+            void read_raw(std::ifstream &file, T *dst, size_t n) {
+                file.read(reinterpret_cast<char *>(dst), n * sizeof(T));
+            }
+
+            template <class T>
+            void write_file(std::string const &path,
+                array<int, 3> const &global_sizes,
+                std::vector<block_info> const &blocks,
+                std::vector<T> const &data) {
+                std::ofstream file(path, std::ios::binary);
+                if (!file)
+                    throw std::runtime_error("streaming_output: cannot open \"" + path + "\"");
+                write_raw(file, magic, 8);
+                std::uint32_t header[2] = {sizeof(T), 3};
+                write_raw(file, header, 2);
+                std::int32_t sizes[3] = {global_sizes[0], global_sizes[1], global_sizes[2]};
+                write_raw(file, sizes, 3);
+                std::uint32_t num_blocks = blocks.size();
+                write_raw(file, &num_blocks, 1);
+                for (auto const &block : blocks) {
+                    std::int32_t desc[6] = {block.begin[0],
+                        block.begin[1],
+                        block.begin[2],
+                        block.sizes[0],
+                        block.sizes[1],
+                        block.sizes[2]};
+                    write_raw(file, desc, 6);
+                }
+                write_raw(file, data.data(), data.size());
+                if (!file)
+                    throw std::runtime_error("streaming_output: cannot write \"" + path + "\"");
+            }
+        } // namespace streaming_output_impl_
+
+        /** Reads a file written by `streaming_output` and copies the blocks it contains into `global`, which
+            is the global field in C order. If `global` is empty, it is resized to the global size.
+
+            \return The global sizes of the field (decreasing strides)
+         */
+        template <class T>
+        array<int, 3> read_output_file(std::string const &path, std::vector<T> &global) {
+            using namespace streaming_output_impl_;
+            std::ifstream file(path, std::ios::binary);
+            char file_magic[8];
+            read_raw(file, file_magic, 8);
+            if (!file || std::memcmp(file_magic, magic, 8))
+                throw std::runtime_error("read_output_file: \"" + path + "\" is not a streaming output file");
+            std::uint32_t header[2];
+            read_raw(file, header, 2);
+            if (header[0] != sizeof(T) || header[1] != 3)
+                throw std::runtime_error("read_output_file: unexpected value size or dimensionality");
+            std::int32_t sizes[3];
+            read_raw(file, sizes, 3);
+            array<int, 3> global_sizes = {sizes[0], sizes[1], sizes[2]};
+            if (global.empty())
+                global.resize(volume(global_sizes));
+            if (global.size() != volume(global_sizes))
+                throw std::runtime_error("read_output_file: global size mismatch");
+            std::uint32_t num_blocks;
+            read_raw(file, &num_blocks, 1);
+            std::vector<std::int32_t> descs(num_blocks * 6);
+            read_raw(file, descs.data(), descs.size());
+            std::vector<T> row;
+            for (std::uint32_t b = 0; b != num_blocks; ++b) {
+                auto desc = &descs[b * 6];
+                row.resize(desc[5]);
+                for (int i = 0; i < desc[3]; ++i)
+                    for (int j = 0; j < desc[4]; ++j) {
+                        read_raw(file, row.data(), row.size());
+                        std::copy(row.begin(),
+                            row.end(),
+                            global.begin() + (size_t(desc[0] + i) * global_sizes[1] + desc[1] + j) * global_sizes[2] +
+                                desc[2]);
+                    }
+            }
+            if (!file)
+                throw std::runtime_error("read_output_file: \"" + path + "\" is truncated");
+            return global_sizes;
+        }
+
+        /** Double-buffered gather of a distributed 3D field to aggregator ranks, which write it to files
+            in the background.
+
+            \tparam vtype Type of the elements of the field
+            \tparam pgrid Type of the 3D process grid
+
+            Example:
+
+            streaming_output<double, MPI_3D_process_grid_t<3>> out(pgrid, local_halos, global_begin, 16, "tracer");
+            for (int step = 0; step < n; ++step) {
+                compute(field);
+                out.write(field.data()); // returns after the sends are posted
+            }
+            out.flush();
+         */
+        template <typename vtype, typename pgrid>
+        class streaming_output {
+          public:
+            typedef vtype value_type;
+            typedef pgrid grid_type;
+            typedef array<halo_descriptor, 3> halo_block;
+
+          private:
+            using block_info = streaming_output_impl_::block_info;
+            using pattern_t = all_to_all_halo<value_type, grid_type>;
+
+            static constexpr size_t num_buffers = 2;
+
+            MPI_Comm m_comm;
+            halo_block m_local;
+            std::string m_prefix;
+            int m_aggregator_index;
+            bool m_is_aggregator;
+            array<int, 3> m_global_sizes;
+            std::vector<block_info> m_group_blocks;
+
+            size_t m_step = 0;
+            std::unique_ptr<pattern_t> m_patterns[num_buffers];
+            std::vector<value_type> m_send_buffers[num_buffers];
+            std::vector<value_type> m_recv_buffers[num_buffers];
+            bool m_sending[num_buffers] = {};
+            bool m_receiving[num_buffers] = {};
+            size_t m_buffer_steps[num_buffers] = {};
+            std::future<void> m_writers[num_buffers];
+
+            array<int, 3> coords_of(int rank) const {
+                array<int, 3> res;
+                MPI_Cart_coords(m_comm, rank, 3, &res[0]);
+                return res;
+            }
+
+            static halo_block contiguous(array<int, 3> const &sizes) {
+                return {halo_descriptor(sizes[0]), halo_descriptor(sizes[1]), halo_descriptor(sizes[2])};
+            }
+
+            void pack(value_type const *field, std::vector<value_type> &dst) const {
+                size_t stride1 = m_local[2].total_length();
+                size_t stride0 = m_local[1].total_length() * stride1;
+                auto out = dst.data();
+                for (uint_t i = m_local[0].begin(); i <= m_local[0].end(); ++i)
+                    for (uint_t j = m_local[1].begin(); j <= m_local[1].end(); ++j) {
+                        auto row = field + i * stride0 + j * stride1;
+                        out = std::copy(row + m_local[2].begin(), row + m_local[2].end() + 1, out);
+                    }
+            }
+
+            void complete_gather(size_t b) {
+                if (!m_receiving[b])
+                    return;
+                m_patterns[b]->wait();
+                m_receiving[b] = false;
+                if (m_is_aggregator)
+                    m_writers[b] = std::async(std::launch::async, [this, b, path = file_name(m_buffer_steps[b])] {
+                        streaming_output_impl_::write_file(path, m_global_sizes, m_group_blocks, m_recv_buffers[b]);
+                    });
+            }
+
+            void release(size_t b) {
+                if (m_writers[b].valid())
+                    m_writers[b].get();
+                if (m_sending[b])
+                    m_patterns[b]->wait_sends();
+                m_sending[b] = false;
+            }
+
+          public:
+            /** Constructor. Collective over the communicator of the process grid.
+
+                \param g The process grid
+                \param local Halo descriptors of the local field (decreasing strides); their interior is written
+                \param global_begin Global coordinates of the first interior point of the local field
+                \param ranks_per_aggregator Number of consecutive ranks whose data is gathered by the same rank
+                \param prefix Prefix of the output file names
+             */
+            streaming_output(grid_type const &g,
+                halo_block const &local,
+                array<int, 3> const &global_begin,
+                int ranks_per_aggregator,
+                std::string prefix)
+                : m_comm(g.communicator()), m_local(local), m_prefix(std::move(prefix)) {
+                if (ranks_per_aggregator < 1)
+                    throw std::runtime_error("streaming_output: ranks_per_aggregator should be positive");
+                int rank, size;
+                MPI_Comm_rank(m_comm, &rank);
+                MPI_Comm_size(m_comm, &size);
+                m_aggregator_index = rank / ranks_per_aggregator;
+                int aggregator = m_aggregator_index * ranks_per_aggregator;
+                m_is_aggregator = rank == aggregator;
+
+                block_info mine;
+                mine.begin = global_begin;
+                for (int d = 0; d < 3; ++d)
+                    mine.sizes[d] = local[d].end() - local[d].begin() + 1;
+                std::vector<block_info> blocks(size);
+                MPI_Allgather(&mine, 6, MPI_INT, blocks.data(), 6, MPI_INT, m_comm);
+                m_global_sizes = {0, 0, 0};
+                for (auto const &block : blocks)
+                    for (int d = 0; d < 3; ++d)
+                        m_global_sizes[d] = std::max(m_global_sizes[d], block.begin[d] + block.sizes[d]);
+
+                size_t group_volume = 0;
+                if (m_is_aggregator) {
+                    int last = std::min(size, aggregator + ranks_per_aggregator);
+                    m_group_blocks.assign(blocks.begin() + aggregator, blocks.begin() + last);
+                    for (auto const &block : m_group_blocks)
+                        group_volume += streaming_output_impl_::volume(block.sizes);
+                }
+
+                for (size_t b = 0; b != num_buffers; ++b) {
+                    m_patterns[b].reset(new pattern_t(g, m_comm));
+                    m_send_buffers[b].resize(streaming_output_impl_::volume(mine.sizes));
+                    m_patterns[b]->register_block_to(
+                        m_send_buffers[b].data(), contiguous(mine.sizes), coords_of(aggregator));
+                    if (m_is_aggregator) {
+                        m_recv_buffers[b].resize(group_volume);
+                        auto dst = m_recv_buffers[b].data();
+                        for (size_t r = 0; r != m_group_blocks.size(); ++r) {
+                            auto const &sizes = m_group_blocks[r].sizes;
+                            m_patterns[b]->register_block_from(dst, contiguous(sizes), coords_of(aggregator + r));
+                            dst += streaming_output_impl_::volume(sizes);
+                        }
+                    }
+                    m_patterns[b]->setup();
+                }
+            }
+
+            streaming_output(streaming_output const &) = delete;
+            streaming_output &operator=(streaming_output const &) = delete;
+
+            /** Waits for the background file writes. `flush` should be called before, while MPI is still
+                initialized, to complete the pending communication.
+             */
+            ~streaming_output() {
+                for (auto &&writer : m_writers)
+                    if (writer.valid())
+                        writer.wait();
+            }
+
+            /** Posts the output of the next step. Collective over the communicator of the process grid.
+
+                The interior of the local field is copied before the function returns, so the field can be
+                modified right away. The gather of the previous step is completed and its file is written
+                in the background.
+             */
+            void write(value_type const *field) {
+                size_t b = m_step % num_buffers;
+                complete_gather((m_step + num_buffers - 1) % num_buffers);
+                release(b);
+                pack(field, m_send_buffers[b]);
+                m_patterns[b]->start_exchange();
+                m_sending[b] = true;
+                m_receiving[b] = true;
+                m_buffer_steps[b] = m_step++;
+            }
+
+            /** Completes all pending gathers and file writes. Rethrows the errors of the file writes.
+             */
+            void flush() {
+                for (size_t b = 0; b != num_buffers; ++b)
+                    complete_gather(b);
+                for (size_t b = 0; b != num_buffers; ++b)
+                    release(b);
+            }
+
+            /** Name of the file written by this rank for the given step, if it is an aggregator
+             */
+            std::string file_name(size_t step) const {
+                return m_prefix + "." + std::to_string(step) + "." + std::to_string(m_aggregator_index) + ".bin";
+            }
+
+            bool is_aggregator() const { return m_is_aggregator; }
+
+            /** Number of steps written so far
+             */
+            size_t steps() const { return m_step; }
+
+            array<int, 3> const &global_sizes() const { return m_global_sizes; }
+        };
+    } // namespace gcl
+} // namespace gridtools
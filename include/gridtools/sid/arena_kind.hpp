@@ -0,0 +1,30 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <type_traits>
+
+namespace gridtools {
+    namespace sid {
+        /**
+         *  A strides kind which additionally promises that all SIDs of this kind point into one allocation.
+         *
+         *  `composite` relies on it to shift the raw pointers of such SIDs through a single base pointer.
+         */
+        template <class Kind>
+        struct arena_kind;
+
+        template <class Kind>
+        struct is_arena_kind : std::false_type {};
+
+        template <class Kind>
+        struct is_arena_kind<arena_kind<Kind>> : std::true_type {};
+    } // namespace sid
+} // namespace gridtools
@@ -19,6 +19,7 @@
 #include "../common/tuple.hpp"
 #include "../common/tuple_util.hpp"
 #include "../meta.hpp"
+#include "arena_kind.hpp"
 #include "blocked_dim.hpp"
 #include "concept.hpp"
 #include "delegate.hpp"
@@ -123,8 +124,20 @@ namespace gridtools {
             template <class...>
             struct kind;
 
+            // blocking doesn't change the pointers, thus the blocked SIDs of one arena stay in it
+            template <class Kind, class BlockMap>
+            struct blocked_kind {
+                using type = kind<Kind, BlockMap>;
+            };
+
+            template <class Kind, class BlockMap>
+            struct blocked_kind<arena_kind<Kind>, BlockMap> {
+                using type = arena_kind<kind<Kind, BlockMap>>;
+            };
+
             template <class Sid, class BlockMap>
-            kind<strides_kind<Sid>, BlockMap> sid_get_strides_kind(blocked_sid<Sid, BlockMap> const &);
+            typename blocked_kind<strides_kind<Sid>, BlockMap>::type sid_get_strides_kind(
+                blocked_sid<Sid, BlockMap> const &);
 
             template <class Sid, class BlockMap>
             using no_common_dims =
@@ -13,6 +13,7 @@
 #include <type_traits>
 #include <utility>
 
+#include "../common/array.hpp"
 #include "../common/defs.hpp"
 #include "../common/generic_metafunctions/for_each.hpp"
 #include "../common/generic_metafunctions/utility.hpp"
@@ -21,6 +22,7 @@
 #include "../common/tuple.hpp"
 #include "../common/tuple_util.hpp"
 #include "../meta.hpp"
+#include "arena_kind.hpp"
 #include "concept.hpp"
 
 namespace gridtools {
@@ -189,6 +191,146 @@ namespace gridtools {
                     friend keys hymap_get_keys(composite_ptr_holder const &) { return {}; }
                 };
 
+                /**
+                 *  The pointer of a composite where some of the members are raw pointers into the same allocation
+                 *  that are shifted in the same way, because they have the same `arena_kind` and element type.
+                 *
+                 *  Every group of such pointers is stored as the pointer of its first member (the base) and the
+                 *  constant byte offsets of the other members relative to it. Shifts touch only the bases, so that
+                 *  the number of pointers that are updated in the inner loops doesn't grow with the number of fields.
+                 *
+                 *  @tparam PtrMap - compile time map from the index of a member to the index of its group.
+                 */
+                template <class PtrMap, class... Ptrs>
+                struct grouped_ptr {
+                    static_assert(sizeof...(Keys) == sizeof...(Ptrs), GT_INTERNAL_ERROR);
+
+                    using groups_t = meta::rename<meta::list, meta::mp_inverse<PtrMap>>;
+                    using primaries_t = meta::transform<meta::second, groups_t>;
+                    using group_indices_t = meta::make_indices_for<groups_t>;
+
+                    template <class I>
+                    using ptr_at = meta::at<meta::list<Ptrs...>, I>;
+
+                    template <class Item>
+                    using is_secondary = bool_constant<
+                        !std::is_same<meta::first<Item>, meta::at<primaries_t, meta::second<Item>>>::value>;
+
+                    using secondaries_t = meta::filter<is_secondary, meta::rename<meta::list, PtrMap>>;
+                    using secondary_indices_t = meta::transform<meta::first, secondaries_t>;
+
+                    meta::rename<tuple, meta::transform<ptr_at, primaries_t>> m_bases;
+                    array<std::ptrdiff_t, meta::length<secondaries_t>::value> m_offsets;
+
+                    template <class Ptr, class Base>
+                    static GT_FUNCTION Ptr add_byte_offset(Base base, std::ptrdiff_t offset) {
+                        using byte_t = meta::if_<std::is_const<std::remove_pointer_t<Ptr>>, char const, char>;
+                        auto bytes = const_cast<byte_t *>(reinterpret_cast<char const *>(base));
+                        return reinterpret_cast<Ptr>(bytes + offset);
+                    }
+
+                    template <class Lhs, class Rhs>
+                    static GT_FUNCTION std::ptrdiff_t byte_offset(Lhs lhs, Rhs rhs) {
+                        return reinterpret_cast<char const *>(lhs) - reinterpret_cast<char const *>(rhs);
+                    }
+
+                    template <class... Primaries, class... Secondaries, class Tup>
+                    static GT_FUNCTION grouped_ptr make(
+                        meta::list<Primaries...>, meta::list<Secondaries...>, Tup const &ptrs) {
+                        return {tuple_util::host_device::make<tuple>(
+                                    tuple_util::host_device::get<Primaries::value>(ptrs)...),
+                            {byte_offset(tuple_util::host_device::get<meta::first<Secondaries>::value>(ptrs),
+                                tuple_util::host_device::get<
+                                    meta::at<primaries_t, meta::second<Secondaries>>::value>(ptrs))...}};
+                    }
+
+                    template <class Tup>
+                    static GT_FUNCTION grouped_ptr make(Tup const &ptrs) {
+                        return make(primaries_t(), secondaries_t(), ptrs);
+                    }
+
+                    template <size_t I,
+                        class Index = std::integral_constant<size_t, I>,
+                        class Group = meta::second<meta::mp_find<PtrMap, Index>>,
+                        std::enable_if_t<!is_secondary<meta::list<Index, Group>>::value, int> = 0>
+                    GT_FUNCTION ptr_at<Index> member() const {
+                        return tuple_util::host_device::get<Group::value>(m_bases);
+                    }
+
+                    template <size_t I,
+                        class Index = std::integral_constant<size_t, I>,
+                        class Group = meta::second<meta::mp_find<PtrMap, Index>>,
+                        std::enable_if_t<is_secondary<meta::list<Index, Group>>::value, int> = 0>
+                    GT_FUNCTION ptr_at<Index> member() const {
+                        return add_byte_offset<ptr_at<Index>>(tuple_util::host_device::get<Group::value>(m_bases),
+                            m_offsets[meta::st_position<secondary_indices_t, Index>::value]);
+                    }
+
+                    template <class Stride, class Offset>
+                    GT_FUNCTION void shift_bases(Stride const &stride, Offset offset) {
+                        gridtools::host_device::for_each<group_indices_t>([&](auto group) GT_FORCE_INLINE_LAMBDA {
+                            using primary_t = meta::at<primaries_t, decltype(group)>;
+                            shift(tuple_util::host_device::get<decltype(group)::value>(m_bases),
+                                tuple_util::host_device::get<primary_t::value>(stride),
+                                offset);
+                        });
+                    }
+
+                    template <class PtrDiff>
+                    GT_FUNCTION grouped_ptr add_to_bases(PtrDiff const &ptr_diff) const {
+                        grouped_ptr res = *this;
+                        gridtools::host_device::for_each<group_indices_t>([&](auto group) GT_FORCE_INLINE_LAMBDA {
+                            using primary_t = meta::at<primaries_t, decltype(group)>;
+                            auto &base = tuple_util::host_device::get<decltype(group)::value>(res.m_bases);
+                            base = base + tuple_util::host_device::get<primary_t::value>(ptr_diff);
+                        });
+                        return res;
+                    }
+
+                    struct getter {
+                        template <size_t I>
+                        static GT_FUNCTION ptr_at<std::integral_constant<size_t, I>> get(grouped_ptr const &obj) {
+                            return obj.template member<I>();
+                        }
+                    };
+                    friend getter tuple_getter(grouped_ptr const &) { return {}; }
+                    friend meta::list<Ptrs...> tuple_to_types(grouped_ptr const &) { return {}; }
+                    friend meta::ctor<tuple<>> tuple_from_types(grouped_ptr const &) { return {}; }
+
+                    GT_FUNCTION decltype(auto) operator*() const {
+                        return tuple_util::host_device::convert_to<hymap::keys<Keys...>::template values>(
+                            tuple_util::host_device::transform(
+                                [](auto const &ptr) -> decltype(auto) { return *ptr; }, *this));
+                    }
+
+                    friend keys hymap_get_keys(grouped_ptr const &) { return {}; }
+                };
+
+                template <class PtrMap, class... PtrHolders>
+                struct grouped_ptr_holder {
+                    static_assert(sizeof...(Keys) == sizeof...(PtrHolders), GT_INTERNAL_ERROR);
+
+                    tuple<PtrHolders...> m_vals;
+                    GT_TUPLE_UTIL_FORWARD_GETTER_TO_MEMBER(grouped_ptr_holder, m_vals);
+                    GT_TUPLE_UTIL_FORWARD_CTORS_TO_MEMBER(grouped_ptr_holder, m_vals);
+
+                    struct from_types_f {
+                        template <class... Ts>
+                        using apply = grouped_ptr_holder<PtrMap, Ts...>;
+                    };
+                    friend meta::list<PtrHolders...> tuple_to_types(grouped_ptr_holder const &) { return {}; }
+                    friend from_types_f tuple_from_types(grouped_ptr_holder const &) { return {}; }
+
+                    GT_FUNCTION auto operator()() const {
+                        using ptr_t =
+                            grouped_ptr<PtrMap, std::decay_t<decltype(std::declval<PtrHolders const &>()())>...>;
+                        return ptr_t::make(tuple_util::host_device::transform(
+                                [](auto const &obj) GT_FORCE_INLINE_LAMBDA { return obj(); }, m_vals));
+                    }
+
+                    friend keys hymap_get_keys(grouped_ptr_holder const &) { return {}; }
+                };
+
                 /**
                  *  Implements strides and ptr_diffs compression based on skipping the objects of the
                  *  same kind.
@@ -270,6 +412,24 @@ namespace gridtools {
                             impl_::composite_shift_impl(ptr.m_vals, stride, offset);
                         }
 
+                        template <class PtrMap, class... Ptrs>
+                        friend GT_FUNCTION grouped_ptr<PtrMap, Ptrs...> operator+(
+                            grouped_ptr<PtrMap, Ptrs...> const &lhs, composite_entity const &rhs) {
+                            return lhs.add_to_bases(rhs);
+                        }
+
+                        template <class PtrMap, class... PtrHolders>
+                        friend grouped_ptr_holder<PtrMap, PtrHolders...> operator+(
+                            grouped_ptr_holder<PtrMap, PtrHolders...> const &lhs, composite_entity const &rhs) {
+                            return tuple_util::transform(impl_::sum(), lhs, rhs);
+                        }
+
+                        template <class PtrMap, class... Ptrs, class Offset>
+                        friend GT_FUNCTION void sid_shift(
+                            grouped_ptr<PtrMap, Ptrs...> &ptr, composite_entity const &stride, Offset offset) {
+                            ptr.shift_bases(stride, offset);
+                        }
+
                         template <class... Ptrs, class Offset>
                         friend GT_FUNCTION void sid_shift(
                             composite_ptr<Ptrs...> &ptr, composite_entity &&stride, Offset offset) {
@@ -340,9 +500,27 @@ namespace gridtools {
                     using get_stride_type =
                         compress<impl_::normalized_stride_type<Key, std::decay_t<strides_type<Sids>>>...>;
 
+                    // The raw pointers with the same arena kind and element type point into one allocation and are
+                    // shifted together, the other pointers form groups of one.
+                    template <class Sid, class I>
+                    using ptr_group_key = meta::if_c<std::is_pointer<ptr_type<Sid>>::value &&
+                                                         is_arena_kind<strides_kind<Sid>>::value,
+                        meta::list<strides_kind<Sid>, std::remove_cv_t<std::remove_pointer_t<ptr_type<Sid>>>>,
+                        I>;
+
+                    using ptr_map_t = impl_::make_index_map<
+                        meta::transform<ptr_group_key, meta::list<Sids...>, meta::make_indices_c<sizeof...(Sids)>>>;
+
+                    using is_grouped_t = bool_constant<(meta::length<meta::mp_inverse<ptr_map_t>>::value <
+                                                        sizeof...(Sids))>;
+
                     // all `SID` types are here
-                    using ptr_holder_t = composite_ptr_holder<ptr_holder_type<Sids>...>;
-                    using ptr_t = composite_ptr<ptr_type<Sids>...>;
+                    using ptr_holder_t = meta::if_<is_grouped_t,
+                        grouped_ptr_holder<ptr_map_t, ptr_holder_type<Sids>...>,
+                        composite_ptr_holder<ptr_holder_type<Sids>...>>;
+                    using ptr_t = meta::if_<is_grouped_t,
+                        grouped_ptr<ptr_map_t, ptr_type<Sids>...>,
+                        composite_ptr<ptr_type<Sids>...>>;
                     using strides_t = meta::rename<stride_hymap_ctor, meta::transform<get_stride_type, stride_keys_t>>;
                     using ptr_diff_t = compress<ptr_diff_type<Sids>...>;
 
@@ -0,0 +1,62 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include "../common/converting_ptr.hpp"
+#include "../common/host_device.hpp"
+#include "concept.hpp"
+#include "delegate.hpp"
+
+namespace gridtools {
+    namespace sid {
+        namespace compute_as_impl_ {
+            template <class Compute, class Sid>
+            struct compute_as_adapter : delegate<Sid> {
+                using stored_t = std::remove_pointer_t<ptr_type<Sid>>;
+
+                struct converting_ptr_holder {
+                    ptr_holder_type<Sid> m_impl;
+
+                    GT_CONSTEXPR GT_FUNCTION converting_ptr_type<Compute, stored_t> operator()() const {
+                        return make_converting_ptr<Compute>(m_impl());
+                    }
+
+                    friend GT_CONSTEXPR GT_FUNCTION converting_ptr_holder operator+(
+                        converting_ptr_holder const &obj, ptr_diff_type<Sid> offset) {
+                        return {obj.m_impl + offset};
+                    }
+                };
+
+                friend converting_ptr_holder sid_get_origin(compute_as_adapter &obj) {
+                    return {get_origin(obj.m_impl)};
+                }
+                friend ptr_diff_type<Sid> sid_get_ptr_diff(compute_as_adapter const &) { return {}; }
+                using delegate<Sid>::delegate;
+            };
+        } // namespace compute_as_impl_
+
+        /**
+         *   Returns a `SID` that is read and written as `Compute` while the data stays in the element type of `src`.
+         *   enabled only if the original ptr_type is a pointer.
+         *
+         *   Example: `sid::compute_as<double>(float_sid)`. Stencils see `double` values; the conversion happens when
+         *   the pointer is dereferenced.
+         */
+        template <class Compute,
+            class Src,
+            std::enable_if_t<std::is_pointer<sid::ptr_type<std::decay_t<Src>>>::value, int> = 0>
+        compute_as_impl_::compute_as_adapter<Compute, Src> compute_as(Src &&src) {
+            return {std::forward<Src>(src)};
+        }
+    } // namespace sid
+} // namespace gridtools
@@ -168,6 +168,52 @@ namespace gridtools {
                 }
             };
 
+            template <class Fun, class Color>
+            struct color_fun {
+                template <class Deref = void, class Ptr, class Strides>
+                GT_FUNCTION void operator()(Ptr const &ptr, Strides const &strides) const {
+                    Fun().template operator()<Deref>(Color(), ptr, strides);
+                }
+            };
+
+            template <class Fun, class = void>
+            struct has_colors : std::false_type {};
+
+            template <class Fun>
+            struct has_colors<Fun, void_t<typename Fun::colors_t>> : std::true_type {};
+
+            namespace lazy {
+                template <class Fun, class = void>
+                struct split_colors {
+                    using type = meta::list<Fun>;
+                };
+
+                template <class Fun>
+                struct split_colors<Fun, void_t<typename Fun::colors_t>> {
+                    using type = meta::transform<meta::curry<color_fun, Fun>::template apply, typename Fun::colors_t>;
+                };
+            } // namespace lazy
+
+            template <class Funs, class Interval, class PlhMap, class Extent, class Execution, class NeedSync>
+            struct cell;
+
+            template <class Interval, class PlhMap, class Extent, class Execution, class NeedSync>
+            struct make_fun_cell_f {
+                template <class Fun>
+                using apply = cell<meta::list<Fun>, Interval, PlhMap, Extent, Execution, NeedSync>;
+            };
+
+            /*
+             *  The cells with a single function for a single color that together compute the given cell, in order.
+             *  The cells with stages without colors are not split.
+             */
+            template <class Funs, class Interval, class PlhMap, class Extent, class Execution, class NeedSync>
+            using split_cell_colors = meta::rename<tuple,
+                meta::if_<meta::any_of<has_colors, Funs>,
+                    meta::transform<make_fun_cell_f<Interval, PlhMap, Extent, Execution, NeedSync>::template apply,
+                        meta::flatten<meta::transform<meta::force<lazy::split_colors>::apply, Funs>>>,
+                    meta::list<cell<Funs, Interval, PlhMap, Extent, Execution, NeedSync>>>>;
+
             template <class Funs, class Interval, class PlhMap, class Extent, class Execution, class NeedSync>
             struct cell {
                 using funs_t = Funs;
@@ -179,6 +225,7 @@ namespace gridtools {
 
                 using plhs_t = meta::transform<get_plh, plh_map_t>;
                 using k_step_t = integral_constant<int_t, core::is_backward<Execution>::value ? -1 : 1>;
+                using color_cells_t = split_cell_colors<Funs, Interval, PlhMap, Extent, Execution, NeedSync>;
 
                 static GT_FUNCTION Funs funs() { return {}; }
                 static GT_FUNCTION Interval interval() { return {}; }
@@ -190,6 +237,11 @@ namespace gridtools {
                 static GT_FUNCTION plhs_t plhs() { return {}; }
                 static GT_FUNCTION k_step_t k_step() { return {}; }
 
+                /*
+                 *  The cell split into one cell per stage and color, for backends that run a separate loop per color.
+                 */
+                static GT_FUNCTION color_cells_t color_cells() { return {}; }
+
                 template <class Deref = void, class Ptr, class Strides>
                 GT_FUNCTION void operator()(Ptr const &ptr, Strides const &strides) const {
                     host_device::for_each<Funs>(run_f<Deref, Ptr, Strides>{ptr, strides});
@@ -409,6 +461,42 @@ namespace gridtools {
             using make_split_view = meta::rename<aggregated_view,
                 meta::transform<make_split_view_item, meta::flatten<meta::transform<fuse_stage_rows, Matrices>>>>;
 
+            namespace lazy {
+                template <class Plh, class = void>
+                struct tridiagonal_systems {
+                    using type = meta::list<>;
+                };
+
+                template <class Plh>
+                struct tridiagonal_systems<Plh, void_t<typename Plh::tridiagonal_system_t>> {
+                    using type = meta::list<typename Plh::tridiagonal_system_t>;
+                };
+
+                template <class View, class Systems, class = void>
+                struct tridiagonal_system {
+                    using type = meta::list<>;
+                };
+
+                template <class View, class System>
+                struct tridiagonal_system<View,
+                    meta::list<System>,
+                    std::enable_if_t<meta::length<View>::value == 2 &&
+                                     meta::length<meta::dedup<typename View::plhs_t>>::value == 7>> {
+                    using type = System;
+                };
+            } // namespace lazy
+
+            /*
+             *  If the view is a single solve of tridiagonal systems along k (two stages that access five fields and
+             *  two temporaries), its temporaries are marked with
+             *  `tridiagonal_system_t = meta::list<Float, Interval, Inf, Diag, Sup, Rhs, Out>` and this alias evaluates
+             *  to that list, otherwise to an empty list. Backends may use a dedicated algorithm for such views.
+             */
+            template <class View>
+            using tridiagonal_system = typename lazy::tridiagonal_system<View,
+                meta::dedup<meta::flatten<
+                    meta::transform<meta::force<lazy::tridiagonal_systems>::apply, typename View::tmp_plhs_t>>>>::type;
+
             using core::is_backward;
             using core::is_forward;
             using core::is_parallel;
@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include "../../common/converting_ptr.hpp"
 #include "../../common/host_device.hpp"
 
 namespace gridtools {
@@ -39,6 +40,20 @@ namespace gridtools {
             using type = T const &;
         };
 
+        // mixed precision fields: read only accessors get the converted value, read/write ones get the proxy
+        template <class Compute, class Stored>
+        struct apply_intent_type<intent::inout, converting_ref<Compute, Stored>> {
+            using type = converting_ref<Compute, Stored>;
+        };
+
+        template <class Compute, class Stored>
+        struct apply_intent_type<intent::inout, converting_ref<Compute, Stored const>> {};
+
+        template <class Compute, class Stored>
+        struct apply_intent_type<intent::in, converting_ref<Compute, Stored>> {
+            using type = Compute;
+        };
+
         template <intent Intent, class T>
         using apply_intent_t = typename apply_intent_type<Intent, T>::type;
 
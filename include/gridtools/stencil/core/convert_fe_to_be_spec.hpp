@@ -83,7 +83,7 @@ namespace gridtools {
                 struct make_esf_row_f {
                     template <class Esf, class NeedSync>
                     using apply = meta::transform<make_cell_f<Msses, DataStores, Mss, Esf, NeedSync>::template apply,
-                        make_functor_map<typename Esf::esf_function_t, Interval>>;
+                        esf_functor_map<typename Esf::esf_function_t, Interval>>;
                 };
 
                 template <class Msses, class Interval, class DataStores>
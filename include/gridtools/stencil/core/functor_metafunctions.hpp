@@ -232,9 +232,54 @@ namespace gridtools {
                 using make_functor_map =
                     meta::transform<item_maker_f<Functor, Interval>::template apply, split_interval<Interval>>;
 
+                /*
+                 *  A functor can provide its own map from the levels to the per-level functors by defining
+                 *  `template <class Interval> using functor_map = ...;`. In that case the functor is responsible for
+                 *  the validation of the apply overloads of the functors it is composed of.
+                 */
+                template <class Functor, class Interval, class = void>
+                struct lazy_esf_functor_map {
+                    using type = make_functor_map<Functor, Interval>;
+                };
+
+                template <class Functor, class Interval>
+                struct lazy_esf_functor_map<Functor,
+                    Interval,
+                    void_t<typename Functor::template functor_map<Interval>>> {
+                    using type = typename Functor::template functor_map<Interval>;
+                };
+
+                template <class Functor, class Interval>
+                using esf_functor_map = typename lazy_esf_functor_map<Functor, Interval>::type;
+
+                template <class Functor, class Interval, class = void>
+                struct check_valid_functor : check_valid_apply_overloads<Functor, Interval> {};
+
+                template <class Functor, class Interval>
+                struct check_valid_functor<Functor, Interval, void_t<typename Functor::template functor_map<Interval>>>
+                    : std::true_type {};
+
+                /*
+                 *  A functor that evaluates temporaries in place lists them as `using inlined_tmps_t = ...;`.
+                 */
+                template <class Functor, class = void>
+                struct lazy_inlined_tmps {
+                    using type = meta::list<>;
+                };
+
+                template <class Functor>
+                struct lazy_inlined_tmps<Functor, void_t<typename Functor::inlined_tmps_t>> {
+                    using type = typename Functor::inlined_tmps_t;
+                };
+
+                template <class Functor>
+                using inlined_tmps = typename lazy_inlined_tmps<Functor>::type;
             } // namespace functor_metafunctions_impl_
             using functor_metafunctions_impl_::bound_functor;
             using functor_metafunctions_impl_::check_valid_apply_overloads;
+            using functor_metafunctions_impl_::check_valid_functor;
+            using functor_metafunctions_impl_::esf_functor_map;
+            using functor_metafunctions_impl_::inlined_tmps;
             using functor_metafunctions_impl_::make_functor_map;
         } // namespace core
     }     // namespace stencil
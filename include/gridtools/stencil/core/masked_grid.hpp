@@ -0,0 +1,205 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "../../common/defs.hpp"
+#include "../../common/host_device.hpp"
+#include "../common/dim.hpp"
+#include "grid.hpp"
+
+/**
+ *  @file
+ *  Grids with inactive columns.
+ *
+ *  A `masked_grid` is a `grid` that additionally carries the set of active (i, j) columns of the computation domain.
+ *  Backends that support masks compute only the active columns and the points that are needed to compute them,
+ *  all other backends treat it like a plain `grid`. Thus the values of the outputs in the inactive columns are
+ *  unspecified.
+ */
+namespace gridtools {
+    namespace stencil {
+        namespace core {
+            /**
+             *  The active columns of a domain extended by an extent, stored as runs of consecutive active columns
+             *  along i for every j. Coordinates are relative to the origin of the computation domain. Copies share
+             *  the runs.
+             */
+            class column_runs {
+                struct rows {
+                    int_t j_start;
+                    std::vector<int_t> row_starts;
+                    std::vector<std::pair<int_t, int_t>> runs;
+                };
+                std::shared_ptr<const rows> m_rows;
+
+                auto row_begin(int_t j) const { return m_rows->runs.begin() + m_rows->row_starts[j - m_rows->j_start]; }
+                auto row_end(int_t j) const {
+                    return m_rows->runs.begin() + m_rows->row_starts[j - m_rows->j_start + 1];
+                }
+
+              public:
+                /**
+                 *  Builds the runs from the predicate `active(i, j)` that is evaluated for
+                 *  `i_start <= i < i_start + i_size` and `j_start <= j < j_start + j_size`.
+                 */
+                template <class Active>
+                column_runs(int_t i_start, int_t i_size, int_t j_start, int_t j_size, Active &&active) {
+                    auto res = std::make_shared<rows>();
+                    res->j_start = j_start;
+                    auto &row_starts = res->row_starts;
+                    auto &runs = res->runs;
+                    row_starts.reserve(j_size + 1);
+                    for (int_t j = j_start; j < j_start + j_size; ++j) {
+                        row_starts.push_back(runs.size());
+                        for (int_t i = i_start; i < i_start + i_size; ++i) {
+                            if (!active(i, j))
+                                continue;
+                            if (runs.size() != (size_t)row_starts.back() && runs.back().second == i)
+                                ++runs.back().second;
+                            else
+                                runs.emplace_back(i, i + 1);
+                        }
+                    }
+                    row_starts.push_back(runs.size());
+                    m_rows = std::move(res);
+                }
+
+                /**
+                 *  Calls `fun(first, last)` for the runs `[first, last)` of active columns in the row `j`
+                 *  clipped to `[i_begin, i_end)`, in increasing order.
+                 */
+                template <class Fun>
+                GT_FORCE_INLINE void for_each_run(int_t j, int_t i_begin, int_t i_end, Fun &&fun) const {
+                    assert(j >= m_rows->j_start && j - m_rows->j_start + 1 < (int_t)m_rows->row_starts.size());
+                    auto last = row_end(j);
+                    auto it = std::upper_bound(row_begin(j), last, i_begin, [](int_t i, auto const &run) {
+                        return i < run.second;
+                    });
+                    for (; it != last && it->first < i_end; ++it)
+                        fun(std::max(it->first, i_begin), std::min(it->second, i_end));
+                }
+
+                /** Whether any column of `[i_begin, i_end) x [j_begin, j_end)` is active. */
+                bool any(int_t i_begin, int_t i_end, int_t j_begin, int_t j_end) const {
+                    bool res = false;
+                    for (int_t j = j_begin; !res && j < j_end; ++j)
+                        for_each_run(j, i_begin, i_end, [&](int_t, int_t) { res = true; });
+                    return res;
+                }
+            };
+
+            /**
+             *  The set of active columns of a computation domain of size `i_size` x `j_size`. The dilated columns are
+             *  computed once per extent and cached.
+             */
+            class column_mask {
+                int_t m_i_size;
+                int_t m_j_size;
+                std::vector<char> m_active;
+                mutable std::mutex m_mutex;
+                mutable std::map<std::array<int_t, 4>, column_runs> m_dilated;
+
+                column_runs dilate(int_t i_minus, int_t i_plus, int_t j_minus, int_t j_plus) const {
+                    int_t i_size = m_i_size - i_minus + i_plus;
+                    int_t j_size = m_j_size - j_minus + j_plus;
+                    // the dilation is separable: first along i, then along j
+                    std::vector<char> rows(i_size * m_j_size);
+                    for (int_t j = 0; j < m_j_size; ++j)
+                        for (int_t i = i_minus; i < i_minus + i_size; ++i) {
+                            bool res = false;
+                            for (int_t d = 0; !res && d <= i_plus - i_minus; ++d)
+                                res = (*this)(i - i_plus + d, j);
+                            rows[j * i_size + i - i_minus] = res;
+                        }
+                    auto row_active = [&](int_t i, int_t j) {
+                        return j >= 0 && j < m_j_size && rows[j * i_size + i - i_minus];
+                    };
+                    return {i_minus, i_size, j_minus, j_size, [&](int_t i, int_t j) {
+                                for (int_t d = 0; d <= j_plus - j_minus; ++d)
+                                    if (row_active(i, j - j_plus + d))
+                                        return true;
+                                return false;
+                            }};
+                }
+
+              public:
+                template <class Active>
+                column_mask(int_t i_size, int_t j_size, Active &&active)
+                    : m_i_size(i_size), m_j_size(j_size), m_active(i_size * j_size) {
+                    for (int_t j = 0; j < j_size; ++j)
+                        for (int_t i = 0; i < i_size; ++i)
+                            m_active[j * i_size + i] = active(i, j);
+                }
+
+                bool operator()(int_t i, int_t j) const {
+                    return i >= 0 && i < m_i_size && j >= 0 && j < m_j_size && m_active[j * m_i_size + i];
+                }
+
+                /**
+                 *  The columns that have to be computed by a stage with the given extent: a column `p` of the
+                 *  extended domain is active if there is an active column `c` with `p - plus <= c <= p - minus`.
+                 */
+                template <class Extent>
+                column_runs const &dilate(Extent extent) const {
+                    std::array<int_t, 4> key = {
+                        extent.minus(dim::i()), extent.plus(dim::i()), extent.minus(dim::j()), extent.plus(dim::j())};
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    auto it = m_dilated.find(key);
+                    if (it == m_dilated.end())
+                        it = m_dilated.emplace(key, dilate(key[0], key[1], key[2], key[3])).first;
+                    return it->second;
+                }
+            };
+
+            template <class Interval>
+            class masked_grid : public grid<Interval> {
+                std::shared_ptr<const column_mask> m_mask;
+
+              public:
+                masked_grid(grid<Interval> const &src, std::shared_ptr<const column_mask> mask)
+                    : grid<Interval>(src), m_mask(std::move(mask)) {
+                    assert(m_mask);
+                }
+
+                column_mask const &mask() const { return *m_mask; }
+            };
+
+            /** All columns are active. */
+            struct all_columns {
+                template <class Fun>
+                GT_FORCE_INLINE void for_each_run(int_t, int_t i_begin, int_t i_end, Fun &&fun) const {
+                    fun(i_begin, i_end);
+                }
+
+                bool any(int_t, int_t, int_t, int_t) const { return true; }
+            };
+
+            /** The columns that have to be computed by a stage with the given extent. */
+            template <class Extent, class Grid>
+            all_columns active_columns(Extent, Grid const &) {
+                return {};
+            }
+
+            template <class Extent, class Interval>
+            column_runs active_columns(Extent extent, masked_grid<Interval> const &grid) {
+                return grid.mask().dilate(extent);
+            }
+        } // namespace core
+    }     // namespace stencil
+} // namespace gridtools
@@ -23,8 +23,10 @@
 #include "../../thread_pool/omp.hpp"
 #include "../be_api.hpp"
 #include "../common/dim.hpp"
+#include "../core/masked_grid.hpp"
 #include "execinfo.hpp"
 #include "loops.hpp"
+#include "pcr.hpp"
 #include "pos3.hpp"
 #include "tmp_storage_sid.hpp"
 
@@ -44,6 +46,9 @@ namespace gridtools {
 
                     execinfo info(ThreadPool(), grid);
 
+                    if (run_pcr<ThreadPool>(be_api::tridiagonal_system<stages_t>(), info, grid, external_data_stores))
+                        return;
+
                     using tmp_plh_map_t = be_api::remove_caches_from_plh_map<typename stages_t::tmp_plh_map_t>;
                     auto temporaries = be_api::make_data_stores(tmp_plh_map_t(),
                         [&alloc,
@@ -78,8 +83,11 @@ namespace gridtools {
                                     return sid::add_const(info.is_const(), at_key<decltype(info.plh())>(data_stores));
                                 },
                                 stage_t::plh_map()));
-                            return make_loop<ThreadPool, stage_t>(
-                                all_parrallel_t(), grid, std::move(composite), std::move(k_sizes));
+                            return make_loop<ThreadPool, stage_t>(all_parrallel_t(),
+                                grid,
+                                std::move(composite),
+                                std::move(k_sizes),
+                                core::active_columns(typename stage_t::extent_t(), grid));
                         },
                         meta::rename<tuple, stages_t>());
 
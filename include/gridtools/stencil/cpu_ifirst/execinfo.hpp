@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <cassert>
+
 #include "../../common/defs.hpp"
 #include "../../common/host_device.hpp"
 #include "../../thread_pool/concept.hpp"
@@ -24,6 +26,8 @@ namespace gridtools {
             struct execinfo_block_kserial {
                 int_t i_block;
                 int_t j_block;
+                int_t i_start;      /** Position of the block along i-axis. */
+                int_t j_start;      /** Position of the block along j-axis. */
                 int_t i_block_size; /** Size of block along i-axis. */
                 int_t j_block_size; /** Size of block along j-axis. */
             };
@@ -35,6 +39,8 @@ namespace gridtools {
             struct execinfo_block_kparallel {
                 int_t i_block;
                 int_t j_block;
+                int_t i_start;      /** Position of the block along i-axis. */
+                int_t j_start;      /** Position of the block along j-axis. */
                 int_t k;            /** Position along k-axis. */
                 int_t i_block_size; /** Size of block along i-axis. */
                 int_t j_block_size; /** Size of block along j-axis. */
@@ -82,6 +88,8 @@ namespace gridtools {
                 GT_FORCE_INLINE execinfo_block_kserial block(int_t i_block_index, int_t j_block_index) const {
                     return {i_block_index,
                         j_block_index,
+                        i_block_index * m_i_block_size,
+                        j_block_index * m_j_block_size,
                         clamped_block_size(m_i_grid_size, i_block_index, m_i_block_size, m_i_blocks),
                         clamped_block_size(m_j_grid_size, j_block_index, m_j_block_size, m_j_blocks)};
                 }
@@ -99,6 +107,8 @@ namespace gridtools {
                     int_t i_block_index, int_t j_block_index, int_t k) const {
                     return {i_block_index,
                         j_block_index,
+                        i_block_index * m_i_block_size,
+                        j_block_index * m_j_block_size,
                         k,
                         clamped_block_size(m_i_grid_size, i_block_index, m_i_block_size, m_i_blocks),
                         clamped_block_size(m_j_grid_size, j_block_index, m_j_block_size, m_j_blocks)};
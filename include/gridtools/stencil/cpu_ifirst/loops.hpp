@@ -58,8 +58,8 @@ namespace gridtools {
                     return {i_size, ptr, strides};
                 }
 
-                template <class ThreadPool, class Stage, class Grid, class Composite, class KSizes>
-                auto make_loop(std::true_type, Grid const &grid, Composite composite, KSizes k_sizes) {
+                template <class ThreadPool, class Stage, class Grid, class Composite, class KSizes, class Columns>
+                auto make_loop(std::true_type, Grid const &grid, Composite composite, KSizes k_sizes, Columns columns) {
                     using extent_t = typename Stage::extent_t;
                     using ptr_diff_t = sid::ptr_diff_type<Composite>;
                     auto strides = sid::get_strides(composite);
@@ -69,7 +69,8 @@ namespace gridtools {
                     return [origin = sid::get_origin(composite) + offset,
                                strides = std::move(strides),
                                k_start = grid.k_start(Stage::interval()),
-                               k_sizes = std::move(k_sizes)](execinfo_block_kparallel const &info) {
+                               k_sizes = std::move(k_sizes),
+                               columns = std::move(columns)](execinfo_block_kparallel const &info) {
                         ptr_diff_t offset{};
                         sid::shift(
                             offset, sid::get_stride<dim::thread>(strides), thread_pool::get_thread_num(ThreadPool()));
@@ -79,19 +80,26 @@ namespace gridtools {
                         auto ptr = origin() + offset;
 
                         int_t j_count = extent_t::extend(dim::j(), info.j_block_size);
-                        int_t i_size = extent_t::extend(dim::i(), info.i_block_size);
+                        int_t i_begin = info.i_start + extent_t::minus(dim::i());
+                        int_t i_end = i_begin + extent_t::extend(dim::i(), info.i_block_size);
+                        int_t j_begin = info.j_start + extent_t::minus(dim::j());
 
                         for (int_t j = 0; j < j_count; ++j) {
                             using namespace literals;
-                            int_t cur = k_start;
-                            tuple_util::for_each(
-                                [&ptr, &strides, &cur, k = info.k, i_size](auto cell, auto k_size) {
-                                    if (k >= cur && k < cur + k_size)
-                                        i_loop(i_size, cell, ptr, strides);
-                                    cur += k_size;
-                                },
-                                Stage::cells(),
-                                k_sizes);
+                            columns.for_each_run(j_begin + j, i_begin, i_end, [&](int_t first, int_t last) {
+                                sid::shift(ptr, sid::get_stride<dim::i>(strides), first - i_begin);
+                                int_t cur = k_start;
+                                tuple_util::for_each(
+                                    [&ptr, &strides, &cur, k = info.k, i_size = last - first](
+                                        auto cell, auto k_size) {
+                                        if (k >= cur && k < cur + k_size)
+                                            i_loop(i_size, cell, ptr, strides);
+                                        cur += k_size;
+                                    },
+                                    Stage::cells(),
+                                    k_sizes);
+                                sid::shift(ptr, sid::get_stride<dim::i>(strides), i_begin - first);
+                            });
                             sid::shift(ptr, sid::get_stride<dim::j>(strides), 1_c);
                         }
                     };
@@ -113,8 +121,9 @@ namespace gridtools {
                         j_blocks);
                 }
 
-                template <class ThreadPool, class Stage, class Grid, class Composite, class KSizes>
-                auto make_loop(std::false_type, Grid const &grid, Composite composite, KSizes k_sizes) {
+                template <class ThreadPool, class Stage, class Grid, class Composite, class KSizes, class Columns>
+                auto make_loop(
+                    std::false_type, Grid const &grid, Composite composite, KSizes k_sizes, Columns columns) {
                     using extent_t = typename Stage::extent_t;
                     using ptr_diff_t = sid::ptr_diff_type<Composite>;
 
@@ -128,7 +137,8 @@ namespace gridtools {
                     return [origin = sid::get_origin(composite) + offset,
                                strides = std::move(strides),
                                k_shift_back = -grid.k_size(Stage::interval()) * Stage::k_step(),
-                               k_sizes = std::move(k_sizes)](execinfo_block_kserial const &info) {
+                               k_sizes = std::move(k_sizes),
+                               columns = std::move(columns)](execinfo_block_kserial const &info) {
                         sid::ptr_diff_type<Composite> offset{};
                         sid::shift(
                             offset, sid::get_stride<dim::thread>(strides), thread_pool::get_thread_num(ThreadPool()));
@@ -137,13 +147,21 @@ namespace gridtools {
                         auto ptr = origin() + offset;
 
                         int_t j_size = extent_t::extend(dim::j(), info.j_block_size);
-                        int_t i_size = extent_t::extend(dim::i(), info.i_block_size);
+                        int_t i_begin = info.i_start + extent_t::minus(dim::i());
+                        int_t i_end = i_begin + extent_t::extend(dim::i(), info.i_block_size);
+                        int_t j_begin = info.j_start + extent_t::minus(dim::j());
 
-                        auto k_i_loops = make_k_i_loops(i_size, ptr, strides);
                         for (int_t j = 0; j < j_size; ++j) {
                             using namespace literals;
-                            tuple_util::for_each(k_i_loops, Stage::cells(), k_sizes);
-                            sid::shift(ptr, sid::get_stride<dim::k>(strides), k_shift_back);
+                            // the columns are independent in k-serial stages, so every run of active columns is
+                            // swept through all k levels before the next one
+                            columns.for_each_run(j_begin + j, i_begin, i_end, [&](int_t first, int_t last) {
+                                sid::shift(ptr, sid::get_stride<dim::i>(strides), first - i_begin);
+                                tuple_util::for_each(
+                                    make_k_i_loops(last - first, ptr, strides), Stage::cells(), k_sizes);
+                                sid::shift(ptr, sid::get_stride<dim::k>(strides), k_shift_back);
+                                sid::shift(ptr, sid::get_stride<dim::i>(strides), i_begin - first);
+                            });
                             sid::shift(ptr, sid::get_stride<dim::j>(strides), 1_c);
                         }
                     };
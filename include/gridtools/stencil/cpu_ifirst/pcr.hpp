@@ -0,0 +1,197 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <utility>
+
+#include "../../common/defs.hpp"
+#include "../../common/hymap.hpp"
+#include "../../meta.hpp"
+#include "../../sid/concept.hpp"
+#include "../../thread_pool/concept.hpp"
+#include "../common/dim.hpp"
+#include "execinfo.hpp"
+#include "tmp_storage_sid.hpp"
+
+/**
+ *  @file
+ *  Parallel cyclic reduction of tridiagonal systems along k.
+ *
+ *  The Thomas algorithm of `solve_tridiagonal` can only be parallelized over the columns. If there are fewer column
+ *  blocks than threads, the systems are solved by parallel cyclic reduction instead: in every step each row `k` is
+ *  combined with the rows `k - s` and `k + s` into a row that couples `k - 2 s`, `k` and `k + 2 s`, until the
+ *  systems are diagonal after `ceil(log2(k_size))` steps. All rows of a step are independent, the steps are
+ *  parallelized over j and k and vectorized along i. The work is `O(log(k_size))` times the work of the Thomas
+ *  algorithm.
+ */
+namespace gridtools {
+    namespace stencil {
+        namespace cpu_ifirst_backend {
+            namespace pcr_impl_ {
+                template <class Sid>
+                auto row_ptr(Sid &sid, int_t j, int_t k) {
+                    auto ptr = sid::get_origin(sid)();
+                    auto &&strides = sid::get_strides(sid);
+                    sid::shift(ptr, sid::get_stride<dim::j>(strides), j);
+                    sid::shift(ptr, sid::get_stride<dim::k>(strides), k);
+                    return ptr;
+                }
+
+                template <class Float, class Sid>
+                GT_FORCE_INLINE void load_row(Float *dst, Sid &sid, int_t i_size, int_t j, int_t k) {
+                    auto ptr = row_ptr(sid, j, k);
+                    auto &&stride = sid::get_stride<dim::i>(sid::get_strides(sid));
+                    for (int_t i = 0; i < i_size; ++i) {
+                        dst[i] = *ptr;
+                        sid::shift(ptr, stride, 1);
+                    }
+                }
+
+                /**
+                 *  Solves `inf(k) out(k - 1) + diag(k) out(k) + sup(k) out(k + 1) = rhs(k)` for
+                 *  `k_start <= k < k_start + k_size` in all columns.
+                 */
+                template <class ThreadPool, class Float, class Inf, class Diag, class Sup, class Rhs, class Out>
+                void solve_tridiagonal_pcr(int_t i_size,
+                    int_t j_size,
+                    int_t k_start,
+                    int_t k_size,
+                    Inf &inf,
+                    Diag &diag,
+                    Sup &sup,
+                    Rhs &rhs,
+                    Out &out) {
+                    tmp_allocator alloc;
+                    int_t row_size = _impl_tmp::pad<Float>(i_size);
+                    int_t size = row_size * j_size * k_size;
+                    auto holder = allocate(alloc, meta::lazy::id<Float>(), 8 * (size_t)size);
+                    Float *a = holder(), *b = a + size, *c = b + size, *d = c + size;
+                    Float *next_a = d + size, *next_b = next_a + size, *next_c = next_b + size, *next_d = next_c + size;
+                    auto row = [=](int_t j, int_t k) { return (k * j_size + j) * row_size; };
+
+                    thread_pool::parallel_for_loop(
+                        ThreadPool(),
+                        [&](int_t j, int_t k) {
+                            int_t r = row(j, k);
+                            load_row(a + r, inf, i_size, j, k_start + k);
+                            load_row(b + r, diag, i_size, j, k_start + k);
+                            load_row(c + r, sup, i_size, j, k_start + k);
+                            load_row(d + r, rhs, i_size, j, k_start + k);
+                            // the coefficients that point outside of the systems
+                            for (int_t i = 0; i < i_size; ++i) {
+                                if (k == 0)
+                                    a[r + i] = 0;
+                                if (k == k_size - 1)
+                                    c[r + i] = 0;
+                            }
+                        },
+                        j_size,
+                        k_size);
+
+                    for (int_t s = 1; s < k_size; s *= 2) {
+                        thread_pool::parallel_for_loop(
+                            ThreadPool(),
+                            [&](int_t j, int_t k) {
+                                // the rows `k - s` and `k + s` exist or the coupling to them is zero, in the latter
+                                // case the row `k` is used instead to keep the loop branch free
+                                int_t r = row(j, k);
+                                int_t rm = row(j, k >= s ? k - s : k);
+                                int_t rp = row(j, k + s < k_size ? k + s : k);
+#pragma omp simd
+                                for (int_t i = 0; i < i_size; ++i) {
+                                    Float alpha = -a[r + i] / b[rm + i];
+                                    Float gamma = -c[r + i] / b[rp + i];
+                                    next_a[r + i] = alpha * a[rm + i];
+                                    next_c[r + i] = gamma * c[rp + i];
+                                    next_b[r + i] = b[r + i] + alpha * c[rm + i] + gamma * a[rp + i];
+                                    next_d[r + i] = d[r + i] + alpha * d[rm + i] + gamma * d[rp + i];
+                                }
+                            },
+                            j_size,
+                            k_size);
+                        std::swap(a, next_a);
+                        std::swap(b, next_b);
+                        std::swap(c, next_c);
+                        std::swap(d, next_d);
+                    }
+
+                    thread_pool::parallel_for_loop(
+                        ThreadPool(),
+                        [&](int_t j, int_t k) {
+                            int_t r = row(j, k);
+                            auto ptr = row_ptr(out, j, k_start + k);
+                            auto &&stride = sid::get_stride<dim::i>(sid::get_strides(out));
+                            for (int_t i = 0; i < i_size; ++i) {
+                                *ptr = d[r + i] / b[r + i];
+                                sid::shift(ptr, stride, 1);
+                            }
+                        },
+                        j_size,
+                        k_size);
+                }
+
+                template <class ThreadPool>
+                bool use_pcr(meta::list<>, execinfo const &) {
+                    return false;
+                }
+
+                /**
+                 *  Whether the computation, described by `be_api::tridiagonal_system`, is solved by parallel cyclic
+                 *  reduction: it is a single tridiagonal solve and there are fewer column blocks than threads.
+                 */
+                template <class ThreadPool, class... Ts>
+                bool use_pcr(meta::list<Ts...>, execinfo const &info) {
+                    return info.i_blocks() * info.j_blocks() < thread_pool::get_max_threads(ThreadPool());
+                }
+
+                template <class ThreadPool, class Grid, class DataStores>
+                bool run_pcr(meta::list<>, execinfo const &, Grid const &, DataStores &) {
+                    return false;
+                }
+
+                /**
+                 *  Solves the systems by parallel cyclic reduction if `use_pcr` selects it.
+                 *
+                 *  @return whether the systems were solved
+                 */
+                template <class ThreadPool,
+                    class Float,
+                    class Interval,
+                    class Inf,
+                    class Diag,
+                    class Sup,
+                    class Rhs,
+                    class Out,
+                    class Grid,
+                    class DataStores>
+                bool run_pcr(meta::list<Float, Interval, Inf, Diag, Sup, Rhs, Out>,
+                    execinfo const &info,
+                    Grid const &grid,
+                    DataStores &data_stores) {
+                    if (!use_pcr<ThreadPool>(meta::list<Float, Interval, Inf, Diag, Sup, Rhs, Out>(), info))
+                        return false;
+                    solve_tridiagonal_pcr<ThreadPool, Float>(grid.i_size(),
+                        grid.j_size(),
+                        grid.k_start(Interval()),
+                        grid.k_size(Interval()),
+                        at_key<Inf>(data_stores),
+                        at_key<Diag>(data_stores),
+                        at_key<Sup>(data_stores),
+                        at_key<Rhs>(data_stores),
+                        at_key<Out>(data_stores));
+                    return true;
+                }
+            } // namespace pcr_impl_
+            using pcr_impl_::run_pcr;
+            using pcr_impl_::solve_tridiagonal_pcr;
+            using pcr_impl_::use_pcr;
+        } // namespace cpu_ifirst_backend
+    }     // namespace stencil
+} // namespace gridtools
@@ -31,11 +31,39 @@
 #include "../thread_pool/omp.hpp"
 #include "be_api.hpp"
 #include "common/dim.hpp"
+#include "core/masked_grid.hpp"
 
 namespace gridtools {
     namespace stencil {
         namespace cpu_kfirst_backend {
-            template <class ThreadPool, class Stage, class Grid, class DataStores>
+            template <class Cell, class Ptr, class Strides>
+            void k_loop_cell(std::false_type, Cell cell, int_t size, Ptr &ptr, Strides const &strides) {
+                for (int_t k = 0; k < size; ++k) {
+                    cell(ptr, strides);
+                    cell.inc_k(ptr, strides);
+                }
+            }
+
+            /*
+             *  The levels of a parallel cell are independent, so the stages of every color are run by a separate loop
+             *  over a column, which is contiguous in the temporaries and in the storages of the cpu_kfirst layout.
+             */
+            template <class Cell, class Ptr, class Strides>
+            void k_loop_cell(std::true_type, Cell, int_t size, Ptr &ptr, Strides const &strides) {
+                tuple_util::for_each(
+                    [&](auto cell) {
+#pragma omp simd
+                        for (int_t k = 0; k < size; ++k) {
+                            cell(ptr, strides);
+                            cell.inc_k(ptr, strides);
+                        }
+                        sid::shift(ptr, sid::get_stride<dim::k>(strides), -size);
+                    },
+                    Cell::color_cells());
+                sid::shift(ptr, sid::get_stride<dim::k>(strides), size);
+            }
+
+            template <class IBlockSize, class JBlockSize, class ThreadPool, class Stage, class Grid, class DataStores>
             auto make_stage_loop(ThreadPool, Stage, Grid const &grid, DataStores &data_stores) {
                 using extent_t = typename Stage::extent_t;
 
@@ -61,10 +89,7 @@ namespace gridtools {
                 auto k_loop = [k_sizes = std::move(k_sizes), shift_back](auto &ptr, auto const &strides) {
                     tuple_util::for_each(
                         [&ptr, &strides](auto cell, auto size) {
-                            for (int_t k = 0; k < size; ++k) {
-                                cell(ptr, strides);
-                                cell.inc_k(ptr, strides);
-                            }
+                            k_loop_cell(be_api::is_parallel<typename Stage::execution_t>(), cell, size, ptr, strides);
                         },
                         Stage::cells(),
                         k_sizes);
@@ -72,7 +97,17 @@ namespace gridtools {
                 };
                 return [origin = sid::get_origin(composite) + offset,
                            strides = std::move(strides),
-                           k_loop = std::move(k_loop)](int_t i_block, int_t j_block, int_t i_size, int_t j_size) {
+                           k_loop = std::move(k_loop),
+                           columns = core::active_columns(extent_t(), grid)](
+                           int_t i_block, int_t j_block, int_t i_size, int_t j_size) {
+                    int_t i_begin = i_block * IBlockSize::value + extent_t::minus(dim::i());
+                    int_t j_begin = j_block * JBlockSize::value + extent_t::minus(dim::j());
+                    // blocks without active columns are skipped
+                    if (!columns.any(i_begin,
+                            i_begin + extent_t::extend(dim::i(), i_size),
+                            j_begin,
+                            j_begin + extent_t::extend(dim::j(), j_size)))
+                        return;
                     ptr_diff_t offset{};
                     sid::shift(
                         offset, sid::get_stride<dim::thread>(strides), thread_pool::get_thread_num(ThreadPool()));
@@ -89,11 +124,23 @@ namespace gridtools {
                 class ThreadPool = thread_pool::omp>
             struct cpu_kfirst {};
 
-            template <class IBlockSize, class JBlockSize, class ThreadPool, class Spec, class Grid, class DataStores>
-            void gridtools_backend_entry_point(cpu_kfirst<IBlockSize, JBlockSize, ThreadPool>,
-                Spec,
-                Grid const &grid,
-                DataStores external_data_stores) {
+            struct no_epilogue_f {
+                void operator()(int_t, int_t, int_t, int_t) const {}
+            };
+
+            /*
+             *  Runs the stages block by block. After the stages of a block, `epilogue(i_begin, i_size, j_begin,
+             *  j_size)` is called on the same thread, with the position of the block relative to the origin of the
+             *  grid.
+             */
+            template <class IBlockSize,
+                class JBlockSize,
+                class ThreadPool,
+                class Spec,
+                class Grid,
+                class DataStores,
+                class Epilogue = no_epilogue_f>
+            void run_blocks(Spec, Grid const &grid, DataStores external_data_stores, Epilogue const &epilogue = {}) {
                 using stages_t = be_api::make_split_view<Spec>;
 
                 auto alloc = sid::make_cached_allocator(&std::make_unique<char[]>);
@@ -107,12 +154,13 @@ namespace gridtools {
                         tuple_util::make<hymap::keys<dim::i, dim::j, dim::k>::values>(-extent.minus(dim::i()),
                             -extent.minus(dim::j()),
                             -grid.k_start(interval) - extent.minus(dim::k()));
-                    auto sizes =
-                        tuple_util::make<hymap::keys<dim::c, dim::k, dim::j, dim::i, dim::thread>::values>(num_colors,
-                            grid.k_size(interval, extent),
-                            extent.extend(dim::j(), JBlockSize()),
-                            extent.extend(dim::i(), IBlockSize()),
-                            thread_pool::get_max_threads(ThreadPool()));
+                    // color-major: the colors of a column are not interleaved
+                    auto sizes = tuple_util::make<hymap::keys<dim::k, dim::j, dim::i, dim::c, dim::thread>::values>(
+                        grid.k_size(interval, extent),
+                        extent.extend(dim::j(), JBlockSize()),
+                        extent.extend(dim::i(), IBlockSize()),
+                        num_colors,
+                        thread_pool::get_max_threads(ThreadPool()));
 
                     using stride_kind = meta::list<decltype(extent), decltype(num_colors)>;
                     return sid::shift_sid_origin(
@@ -129,7 +177,9 @@ namespace gridtools {
                 auto data_stores = hymap::concat(std::move(blocked_external_data_stores), std::move(temporaries));
 
                 auto stage_loops = tuple_util::transform(
-                    [&](auto stage) { return make_stage_loop(ThreadPool(), stage, grid, data_stores); },
+                    [&](auto stage) {
+                        return make_stage_loop<IBlockSize, JBlockSize>(ThreadPool(), stage, grid, data_stores);
+                    },
                     meta::rename<tuple, stages_t>());
 
                 int_t total_i = grid.i_size();
@@ -143,10 +193,19 @@ namespace gridtools {
                         int_t i_size = bi + 1 == NBI ? total_i - bi * IBlockSize::value : IBlockSize::value;
                         int_t j_size = bj + 1 == NBJ ? total_j - bj * JBlockSize::value : JBlockSize::value;
                         tuple_util::for_each([=](auto &&fun) { fun(bi, bj, i_size, j_size); }, stage_loops);
+                        epilogue(bi * IBlockSize::value, i_size, bj * JBlockSize::value, j_size);
                     },
                     NBJ,
                     NBI);
             }
+
+            template <class IBlockSize, class JBlockSize, class ThreadPool, class Spec, class Grid, class DataStores>
+            void gridtools_backend_entry_point(cpu_kfirst<IBlockSize, JBlockSize, ThreadPool>,
+                Spec spec,
+                Grid const &grid,
+                DataStores external_data_stores) {
+                run_blocks<IBlockSize, JBlockSize, ThreadPool>(spec, grid, std::move(external_data_stores));
+            }
         } // namespace cpu_kfirst_backend
         using cpu_kfirst_backend::cpu_kfirst;
     } // namespace stencil
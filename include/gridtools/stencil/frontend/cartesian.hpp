@@ -12,6 +12,8 @@
 #include "cartesian/accessor.hpp"
 #include "cartesian/dimension.hpp"
 #include "cartesian/expressions.hpp"
+#include "cartesian/inlined.hpp"
 #include "cartesian/stage.hpp"
 #include "cartesian/stencil_functions.hpp"
 #include "cartesian/tmp_arg.hpp"
+#include "cartesian/vertical_solvers.hpp"
@@ -9,7 +9,9 @@
  */
 #pragma once
 
+#include "expressions/evaluation.hpp"
 #include "expressions/expr_divide.hpp"
+#include "expressions/expr_fma.hpp"
 #include "expressions/expr_minus.hpp"
 #include "expressions/expr_plus.hpp"
 #include "expressions/expr_pow.hpp"
@@ -0,0 +1,577 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include "../../../../common/generic_metafunctions/utility.hpp"
+#include "../../../../common/host_device.hpp"
+#include "../../../../common/tuple.hpp"
+#include "../../../../common/tuple_util.hpp"
+#include "../../../../meta.hpp"
+#include "expr_base.hpp"
+#include "expr_divide.hpp"
+#include "expr_fma.hpp"
+#include "expr_minus.hpp"
+#include "expr_plus.hpp"
+#include "expr_pow.hpp"
+#include "expr_times.hpp"
+
+/**
+ *  @file
+ *  Evaluation of the expressions.
+ *
+ *  An expression is first rewritten at compile time:
+ *    - `a * b + c`, `c + a * b`, `a * b - c` and `c - a * b` are contracted into `fma`;
+ *    - `a + (-b)`, `a - (-b)` and `-a + b` become `a - b`, `a + b` and `b - a`;
+ *    - unary plus, double negation and `pow<1>` are removed, negated constants are folded.
+ *
+ *  The rewritten tree is then evaluated with every accessor loaded once: leaves of the same accessor type with equal
+ *  offsets share the loaded value. Floating point divisions by equal denominators share one reciprocal.
+ *  The offsets are runtime members of the accessors, but they are constants in the stencil code, hence the equality
+ *  checks are folded by the compiler.
+ */
+namespace gridtools {
+    namespace stencil {
+        namespace cartesian {
+            namespace expressions {
+                namespace evaluation_impl_ {
+                    template <int I>
+                    struct prio : prio<I - 1> {};
+                    template <>
+                    struct prio<0> {};
+
+                    struct rewrite {
+                        template <class T, std::enable_if_t<std::is_arithmetic<T>::value, int> = 0>
+                        static GT_FUNCTION GT_CONSTEXPR T negate(T arg) {
+                            return -arg;
+                        }
+
+                        template <class T, std::enable_if_t<!std::is_arithmetic<T>::value, int> = 0>
+                        static GT_FUNCTION GT_CONSTEXPR expr<minus_f, T> negate(T arg) {
+                            return {arg};
+                        }
+
+                        template <class T>
+                        static GT_FUNCTION GT_CONSTEXPR T negate(expr<minus_f, T> arg) {
+                            return arg.m_arg;
+                        }
+
+                        template <class A, class B, class C>
+                        static GT_FUNCTION GT_CONSTEXPR expr<fma_f, A, B, C> make_fma(A a, B b, C c) {
+                            return {a, b, c};
+                        }
+
+                        template <class T>
+                        static GT_FUNCTION GT_CONSTEXPR T unary(plus_f, T arg) {
+                            return arg;
+                        }
+
+                        template <class T>
+                        static GT_FUNCTION GT_CONSTEXPR auto unary(minus_f, T arg) {
+                            return negate(arg);
+                        }
+
+                        template <class T>
+                        static GT_FUNCTION GT_CONSTEXPR T unary(pow_f<1>, T arg) {
+                            return arg;
+                        }
+
+                        template <class Op, class T>
+                        static GT_FUNCTION GT_CONSTEXPR expr<Op, T> unary(Op, T arg) {
+                            return {arg};
+                        }
+
+                        // a + (-b) -> a - b
+                        template <class L, class R>
+                        static GT_FUNCTION GT_CONSTEXPR auto binary(plus_f, L lhs, expr<minus_f, R> rhs, prio<4>) {
+                            return binary(minus_f(), lhs, rhs.m_arg, prio<4>());
+                        }
+
+                        // a - (-b) -> a + b
+                        template <class L, class R>
+                        static GT_FUNCTION GT_CONSTEXPR auto binary(minus_f, L lhs, expr<minus_f, R> rhs, prio<4>) {
+                            return binary(plus_f(), lhs, rhs.m_arg, prio<4>());
+                        }
+
+                        // -a + b -> b - a
+                        template <class L, class R>
+                        static GT_FUNCTION GT_CONSTEXPR auto binary(plus_f, expr<minus_f, L> lhs, R rhs, prio<3>) {
+                            return binary(minus_f(), rhs, lhs.m_arg, prio<4>());
+                        }
+
+                        // a * b + c -> fma(a, b, c)
+                        template <class A, class B, class C>
+                        static GT_FUNCTION GT_CONSTEXPR auto binary(plus_f, expr<times_f, A, B> lhs, C rhs, prio<2>) {
+                            return make_fma(lhs.m_lhs, lhs.m_rhs, rhs);
+                        }
+
+                        // a * b - c -> fma(a, b, -c)
+                        template <class A, class B, class C>
+                        static GT_FUNCTION GT_CONSTEXPR auto binary(minus_f, expr<times_f, A, B> lhs, C rhs, prio<2>) {
+                            return make_fma(lhs.m_lhs, lhs.m_rhs, negate(rhs));
+                        }
+
+                        // c + a * b -> fma(a, b, c)
+                        template <class A, class B, class C>
+                        static GT_FUNCTION GT_CONSTEXPR auto binary(plus_f, C lhs, expr<times_f, A, B> rhs, prio<1>) {
+                            return make_fma(rhs.m_lhs, rhs.m_rhs, lhs);
+                        }
+
+                        // c - a * b -> fma(-a, b, c)
+                        template <class A, class B, class C>
+                        static GT_FUNCTION GT_CONSTEXPR auto binary(minus_f, C lhs, expr<times_f, A, B> rhs, prio<1>) {
+                            return make_fma(negate(rhs.m_lhs), rhs.m_rhs, lhs);
+                        }
+
+                        template <class Op, class L, class R>
+                        static GT_FUNCTION GT_CONSTEXPR expr<Op, L, R> binary(Op, L lhs, R rhs, prio<0>) {
+                            return {lhs, rhs};
+                        }
+
+                        template <class T>
+                        static GT_FUNCTION GT_CONSTEXPR T apply(T arg) {
+                            return arg;
+                        }
+
+                        template <class Op, class T>
+                        static GT_FUNCTION GT_CONSTEXPR auto apply(expr<Op, T> arg) {
+                            return unary(Op(), apply(arg.m_arg));
+                        }
+
+                        template <class Op, class L, class R>
+                        static GT_FUNCTION GT_CONSTEXPR auto apply(expr<Op, L, R> arg) {
+                            return binary(Op(), apply(arg.m_lhs), apply(arg.m_rhs), prio<4>());
+                        }
+
+                        template <class Op, class A, class B, class C>
+                        static GT_FUNCTION GT_CONSTEXPR auto apply(expr<Op, A, B, C> arg) {
+                            return make_expr(Op(), apply(arg.m_first), apply(arg.m_second), apply(arg.m_third));
+                        }
+                    };
+
+                    template <class T>
+                    using is_leaf = bool_constant<!std::is_arithmetic<T>::value && !is_expr<T>::value>;
+
+                    /*
+                     *  Compile time description of a tree, which starts with the leaf `L` and with the denominator `D`
+                     *  in the evaluation order. `leaves_t` are the accessors in post-order, `dens_t` are the
+                     *  denominators of the divisions in pre-order.
+                     */
+                    template <class T, size_t L, size_t D, class = void>
+                    struct tree_info {
+                        using leaves_t = meta::list<T>;
+                        using dens_t = meta::list<>;
+                    };
+
+                    template <class T, size_t L, size_t D>
+                    struct tree_info<T, L, D, std::enable_if_t<std::is_arithmetic<T>::value>> {
+                        using leaves_t = meta::list<>;
+                        using dens_t = meta::list<>;
+                    };
+
+                    template <class Info>
+                    using num_leaves = meta::length<typename Info::leaves_t>;
+
+                    template <class Info>
+                    using num_dens = meta::length<typename Info::dens_t>;
+
+                    template <size_t L, size_t D, class... Ts>
+                    struct seq_info {
+                        using leaves_t = meta::list<>;
+                        using dens_t = meta::list<>;
+                    };
+
+                    template <size_t L, size_t D, class T, class... Ts>
+                    struct seq_info<L, D, T, Ts...> {
+                        using head_t = tree_info<T, L, D>;
+                        using tail_t = seq_info<L + num_leaves<head_t>::value, D + num_dens<head_t>::value, Ts...>;
+                        using leaves_t = meta::concat<typename head_t::leaves_t, typename tail_t::leaves_t>;
+                        using dens_t = meta::concat<typename head_t::dens_t, typename tail_t::dens_t>;
+                    };
+
+                    template <class Op, class... Ts, size_t L, size_t D>
+                    struct tree_info<expr<Op, Ts...>, L, D> : seq_info<L, D, Ts...> {};
+
+                    template <class T, size_t L, size_t D, bool HasDivisions>
+                    struct den_info {
+                        using type = T;
+                        static constexpr size_t leaf = L;
+                        static constexpr size_t den = D;
+                        static constexpr bool has_divisions = HasDivisions;
+                    };
+
+                    template <class Lhs, class Rhs, size_t L, size_t D>
+                    struct tree_info<expr<divide_f, Lhs, Rhs>, L, D> {
+                        using lhs_t = tree_info<Lhs, L, D + 1>;
+                        using rhs_t = tree_info<Rhs, L + num_leaves<lhs_t>::value, D + 1 + num_dens<lhs_t>::value>;
+                        using leaves_t = meta::concat<typename lhs_t::leaves_t, typename rhs_t::leaves_t>;
+                        using dens_t = meta::concat<meta::list<den_info<Rhs,
+                                                        L + num_leaves<lhs_t>::value,
+                                                        D + 1 + num_dens<lhs_t>::value,
+                                                        num_dens<rhs_t>::value != 0>>,
+                            typename lhs_t::dens_t,
+                            typename rhs_t::dens_t>;
+                    };
+
+                    template <class Op, class T>
+                    GT_FUNCTION tuple<T> children(expr<Op, T> const &arg) {
+                        return {arg.m_arg};
+                    }
+
+                    template <class Op, class L, class R>
+                    GT_FUNCTION tuple<L, R> children(expr<Op, L, R> const &arg) {
+                        return {arg.m_lhs, arg.m_rhs};
+                    }
+
+                    template <class Op, class A, class B, class C>
+                    GT_FUNCTION tuple<A, B, C> children(expr<Op, A, B, C> const &arg) {
+                        return {arg.m_first, arg.m_second, arg.m_third};
+                    }
+
+                    struct collect_leaves_f {
+                        template <class T, std::enable_if_t<is_leaf<T>::value, int> = 0>
+                        GT_FUNCTION tuple<T> operator()(T const &arg) const {
+                            return {arg};
+                        }
+
+                        template <class T, std::enable_if_t<std::is_arithmetic<T>::value, int> = 0>
+                        GT_FUNCTION tuple<> operator()(T) const {
+                            return {};
+                        }
+
+                        template <class Op, class... Ts>
+                        GT_FUNCTION auto operator()(expr<Op, Ts...> const &arg) const {
+                            return tuple_util::host_device::flatten(
+                                tuple_util::host_device::transform(*this, children(arg)));
+                        }
+                    };
+
+                    struct collect_dens_f {
+                        template <class T, std::enable_if_t<!is_expr<T>::value, int> = 0>
+                        GT_FUNCTION tuple<> operator()(T const &) const {
+                            return {};
+                        }
+
+                        template <class Op, class... Ts>
+                        GT_FUNCTION auto operator()(expr<Op, Ts...> const &arg) const {
+                            return tuple_util::host_device::flatten(
+                                tuple_util::host_device::transform(*this, children(arg)));
+                        }
+
+                        template <class Lhs, class Rhs>
+                        GT_FUNCTION auto operator()(expr<divide_f, Lhs, Rhs> const &arg) const {
+                            return tuple_util::host_device::flatten(
+                                tuple_util::host_device::make<tuple>(
+                                    tuple<Rhs>{arg.m_rhs}, (*this)(arg.m_lhs), (*this)(arg.m_rhs)));
+                        }
+                    };
+
+                    template <class T>
+                    GT_FUNCTION GT_CONSTEXPR auto leaf_equal(T const &lhs, T const &rhs, int)
+                        -> decltype(bool(lhs == rhs)) {
+                        return lhs == rhs;
+                    }
+
+                    template <class T>
+                    GT_FUNCTION GT_CONSTEXPR bool leaf_equal(T const &, T const &, long) {
+                        return false;
+                    }
+
+                    template <class T, std::enable_if_t<!is_expr<T>::value, int> = 0>
+                    GT_FUNCTION GT_CONSTEXPR bool tree_equal(T const &lhs, T const &rhs) {
+                        return leaf_equal(lhs, rhs, 0);
+                    }
+
+                    template <class Op, class T>
+                    GT_FUNCTION GT_CONSTEXPR bool tree_equal(expr<Op, T> const &lhs, expr<Op, T> const &rhs) {
+                        return tree_equal(lhs.m_arg, rhs.m_arg);
+                    }
+
+                    template <class Op, class L, class R>
+                    GT_FUNCTION GT_CONSTEXPR bool tree_equal(expr<Op, L, R> const &lhs, expr<Op, L, R> const &rhs) {
+                        return tree_equal(lhs.m_lhs, rhs.m_lhs) && tree_equal(lhs.m_rhs, rhs.m_rhs);
+                    }
+
+                    template <class Op, class A, class B, class C>
+                    GT_FUNCTION GT_CONSTEXPR bool tree_equal(
+                        expr<Op, A, B, C> const &lhs, expr<Op, A, B, C> const &rhs) {
+                        return tree_equal(lhs.m_first, rhs.m_first) && tree_equal(lhs.m_second, rhs.m_second) &&
+                               tree_equal(lhs.m_third, rhs.m_third);
+                    }
+
+                    template <class List, class T>
+                    struct same_as_at {
+                        template <class I>
+                        using apply = std::is_same<meta::at<List, I>, T>;
+                    };
+
+                    // indices of the leaves before `I` that have the same type
+                    template <class Leaves, size_t I>
+                    using leaf_candidates_t = meta::filter<same_as_at<Leaves, meta::at_c<Leaves, I>>::template apply,
+                        meta::make_indices_c<I>>;
+
+                    template <class DenInfo>
+                    struct same_den {
+                        template <class Info>
+                        using apply = bool_constant<std::is_same<typename Info::type, typename DenInfo::type>::value &&
+                                                    !Info::has_divisions>;
+                    };
+
+                    template <class DenInfos, class I>
+                    struct same_den_at {
+                        template <class J>
+                        using apply = bool_constant<J::value != I::value &&
+                                                    same_den<meta::at<DenInfos, I>>::template apply<
+                                                        meta::at<DenInfos, J>>::value>;
+                    };
+
+                    // indices of the other denominators that have the same type
+                    template <class DenInfos, size_t K>
+                    using den_candidates_t = meta::filter<same_den_at<DenInfos, std::integral_constant<size_t, K>>::
+                                                              template apply,
+                        meta::make_indices_for<DenInfos>>;
+
+                    struct no_reciprocal {};
+
+                    template <class T>
+                    struct reciprocal {
+                        bool m_shared;
+                        T m_value;
+                    };
+
+                    template <class Vals, class Recips>
+                    struct context {
+                        Vals const &m_vals;
+                        Recips const &m_recips;
+
+                        template <size_t L, size_t D, class T, std::enable_if_t<std::is_arithmetic<T>::value, int> = 0>
+                        GT_FUNCTION T value_of(T arg) const {
+                            return arg;
+                        }
+
+                        template <size_t L, size_t D, class T, std::enable_if_t<is_leaf<T>::value, int> = 0>
+                        GT_FUNCTION auto value_of(T const &) const {
+                            return tuple_util::host_device::get<L>(m_vals);
+                        }
+
+                        template <size_t L, size_t D, class Op, class T>
+                        GT_FUNCTION auto value_of(expr<Op, T> const &arg) const {
+                            return Op()(value_of<L, D>(arg.m_arg));
+                        }
+
+                        template <size_t L, size_t D, class Op, class Lhs, class Rhs>
+                        GT_FUNCTION auto value_of(expr<Op, Lhs, Rhs> const &arg) const {
+                            using lhs_t = tree_info<Lhs, L, D>;
+                            return Op()(value_of<L, D>(arg.m_lhs),
+                                value_of<L + num_leaves<lhs_t>::value, D + num_dens<lhs_t>::value>(arg.m_rhs));
+                        }
+
+                        template <size_t L, size_t D, class Op, class A, class B, class C>
+                        GT_FUNCTION auto value_of(expr<Op, A, B, C> const &arg) const {
+                            using a_t = tree_info<A, L, D>;
+                            using b_t = tree_info<B, L + num_leaves<a_t>::value, D + num_dens<a_t>::value>;
+                            return Op()(value_of<L, D>(arg.m_first),
+                                value_of<L + num_leaves<a_t>::value, D + num_dens<a_t>::value>(arg.m_second),
+                                value_of<L + num_leaves<a_t>::value + num_leaves<b_t>::value,
+                                    D + num_dens<a_t>::value + num_dens<b_t>::value>(arg.m_third));
+                        }
+
+                        template <size_t L, size_t D, class Lhs, class Rhs>
+                        GT_FUNCTION auto value_of(expr<divide_f, Lhs, Rhs> const &arg) const {
+                            using lhs_t = tree_info<Lhs, L, D + 1>;
+                            return divide<L + num_leaves<lhs_t>::value, D + 1 + num_dens<lhs_t>::value>(
+                                value_of<L, D + 1>(arg.m_lhs),
+                                arg.m_rhs,
+                                tuple_util::host_device::get<D>(m_recips));
+                        }
+
+                        template <size_t L, size_t D, class Lhs, class Rhs>
+                        GT_FUNCTION auto divide(Lhs const &lhs, Rhs const &rhs, no_reciprocal) const {
+                            return divide_f()(lhs, value_of<L, D>(rhs));
+                        }
+
+                        template <size_t L, size_t D, class Lhs, class Rhs, class T>
+                        GT_FUNCTION auto divide(Lhs const &lhs, Rhs const &rhs, reciprocal<T> const &recip) const {
+                            return recip.m_shared ? lhs * recip.m_value : divide_f()(lhs, value_of<L, D>(rhs));
+                        }
+                    };
+
+                    template <class... Ts, class T, size_t... Is>
+                    GT_FUNCTION tuple<Ts..., T> append_impl(tuple<Ts...> &&tup, T &&val, std::index_sequence<Is...>) {
+                        return {tuple_util::host_device::get<Is>(wstd::move(tup))..., wstd::move(val)};
+                    }
+
+                    // unlike `tuple_util::push_back`, stores the new element by value
+                    template <class... Ts, class T>
+                    GT_FUNCTION tuple<Ts..., T> append(tuple<Ts...> tup, T val) {
+                        return append_impl(wstd::move(tup), wstd::move(val), std::index_sequence_for<Ts...>());
+                    }
+
+                    template <class Vals, class Recips>
+                    GT_FUNCTION context<Vals, Recips> make_context(Vals const &vals, Recips const &recips) {
+                        return {vals, recips};
+                    }
+
+                    template <size_t I, class Eval, class Leaves, class Vals>
+                    GT_FUNCTION auto load_leaf(Eval &eval, Leaves const &leaves, Vals const &, meta::list<>) {
+                        return std::decay_t<decltype(eval(tuple_util::host_device::get<I>(leaves)))>(
+                            eval(tuple_util::host_device::get<I>(leaves)));
+                    }
+
+                    template <size_t I, class Eval, class Leaves, class Vals, class J, class... Js>
+                    GT_FUNCTION auto load_leaf(
+                        Eval &eval, Leaves const &leaves, Vals const &vals, meta::list<J, Js...>) {
+                        return leaf_equal(tuple_util::host_device::get<I>(leaves),
+                                   tuple_util::host_device::get<J::value>(leaves),
+                                   0)
+                                   ? tuple_util::host_device::get<J::value>(vals)
+                                   : load_leaf<I>(eval, leaves, vals, meta::list<Js...>());
+                    }
+
+                    template <class LeafTypes,
+                        size_t I,
+                        class Eval,
+                        class Leaves,
+                        class Vals,
+                        std::enable_if_t<I == meta::length<LeafTypes>::value, int> = 0>
+                    GT_FUNCTION Vals load_leaves(Eval &, Leaves const &, Vals vals) {
+                        return vals;
+                    }
+
+                    template <class LeafTypes,
+                        size_t I,
+                        class Eval,
+                        class Leaves,
+                        class Vals,
+                        std::enable_if_t<(I < meta::length<LeafTypes>::value), int> = 0>
+                    GT_FUNCTION auto load_leaves(Eval &eval, Leaves const &leaves, Vals vals) {
+                        auto val = load_leaf<I>(eval, leaves, vals, leaf_candidates_t<LeafTypes, I>());
+                        return load_leaves<LeafTypes, I + 1>(
+                            eval, leaves, append(wstd::move(vals), wstd::move(val)));
+                    }
+
+                    template <class DenInfos, size_t K, class Dens, class Vals>
+                    GT_FUNCTION auto den_value(Dens const &dens, Vals const &vals) {
+                        using info_t = meta::at_c<DenInfos, K>;
+                        tuple<> no_recips;
+                        return make_context(vals, no_recips)
+                            .template value_of<info_t::leaf, info_t::den>(tuple_util::host_device::get<K>(dens));
+                    }
+
+                    template <size_t K, class Dens>
+                    GT_FUNCTION bool any_equal(Dens const &, meta::list<>) {
+                        return false;
+                    }
+
+                    template <size_t K, class Dens, class J, class... Js>
+                    GT_FUNCTION bool any_equal(Dens const &dens, meta::list<J, Js...>) {
+                        return tree_equal(tuple_util::host_device::get<K>(dens),
+                                   tuple_util::host_device::get<J::value>(dens)) ||
+                               any_equal<K>(dens, meta::list<Js...>());
+                    }
+
+                    template <class DenInfos, size_t K, class T, class Dens, class Vals, class Recips>
+                    GT_FUNCTION T shared_reciprocal(Dens const &dens, Vals const &vals, Recips const &, meta::list<>) {
+                        return T(1) / den_value<DenInfos, K>(dens, vals);
+                    }
+
+                    // reuses the reciprocal of an equal denominator that was computed before
+                    template <class DenInfos,
+                        size_t K,
+                        class T,
+                        class Dens,
+                        class Vals,
+                        class Recips,
+                        class J,
+                        class... Js>
+                    GT_FUNCTION T shared_reciprocal(
+                        Dens const &dens, Vals const &vals, Recips const &recips, meta::list<J, Js...>) {
+                        return tree_equal(tuple_util::host_device::get<K>(dens),
+                                   tuple_util::host_device::get<J::value>(dens))
+                                   ? tuple_util::host_device::get<J::value>(recips).m_value
+                                   : shared_reciprocal<DenInfos, K, T>(dens, vals, recips, meta::list<Js...>());
+                    }
+
+                    template <size_t K>
+                    struct less_than {
+                        template <class J>
+                        using apply = bool_constant<(J::value < K)>;
+                    };
+
+                    template <class DenInfos, size_t K, class T, class Dens, class Vals, class Recips, class Candidates>
+                    GT_FUNCTION no_reciprocal make_reciprocal(
+                        Dens const &, Vals const &, Recips const &, Candidates, std::false_type) {
+                        return {};
+                    }
+
+                    template <class DenInfos, size_t K, class T, class Dens, class Vals, class Recips, class Candidates>
+                    GT_FUNCTION reciprocal<T> make_reciprocal(
+                        Dens const &dens, Vals const &vals, Recips const &recips, Candidates, std::true_type) {
+                        bool shared = any_equal<K>(dens, Candidates());
+                        return {shared,
+                            shared ? shared_reciprocal<DenInfos, K, T>(
+                                         dens, vals, recips, meta::filter<less_than<K>::template apply, Candidates>())
+                                   : T()};
+                    }
+
+                    template <class DenInfos,
+                        size_t K,
+                        class Dens,
+                        class Vals,
+                        class Recips,
+                        std::enable_if_t<K == meta::length<DenInfos>::value, int> = 0>
+                    GT_FUNCTION Recips make_reciprocals(Dens const &, Vals const &, Recips recips) {
+                        return recips;
+                    }
+
+                    template <class DenInfos,
+                        size_t K,
+                        class Dens,
+                        class Vals,
+                        class Recips,
+                        std::enable_if_t<(K < meta::length<DenInfos>::value), int> = 0>
+                    GT_FUNCTION auto make_reciprocals(Dens const &dens, Vals const &vals, Recips recips) {
+                        using info_t = meta::at_c<DenInfos, K>;
+                        using candidates_t = den_candidates_t<DenInfos, K>;
+                        using value_t = std::decay_t<decltype(den_value<DenInfos, K>(dens, vals))>;
+                        auto recip = make_reciprocal<DenInfos, K, value_t>(dens,
+                            vals,
+                            recips,
+                            candidates_t(),
+                            bool_constant<!info_t::has_divisions && !meta::is_empty<candidates_t>::value &&
+                                          std::is_floating_point<value_t>::value>());
+                        return make_reciprocals<DenInfos, K + 1>(
+                            dens, vals, append(wstd::move(recips), wstd::move(recip)));
+                    }
+
+                    template <class Eval, class Tree>
+                    GT_FUNCTION auto evaluate(Eval &eval, Tree const &tree) {
+                        using info_t = tree_info<Tree, 0, 0>;
+                        auto vals =
+                            load_leaves<typename info_t::leaves_t, 0>(eval, collect_leaves_f()(tree), tuple<>());
+                        auto recips =
+                            make_reciprocals<typename info_t::dens_t, 0>(collect_dens_f()(tree), vals, tuple<>());
+                        return make_context(vals, recips).template value_of<0, 0>(tree);
+                    }
+                } // namespace evaluation_impl_
+
+                namespace evaluation {
+                    template <class Eval, class Op, class... Args>
+                    GT_FUNCTION auto value(Eval &&eval, expr<Op, Args...> arg) {
+                        return evaluation_impl_::evaluate(eval, evaluation_impl_::rewrite::apply(wstd::move(arg)));
+                    }
+                } // namespace evaluation
+            }     // namespace expressions
+        }         // namespace cartesian
+    }             // namespace stencil
+} // namespace gridtools
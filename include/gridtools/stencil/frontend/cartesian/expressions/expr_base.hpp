@@ -38,6 +38,13 @@ namespace gridtools {
                 Rhs m_rhs;
             };
 
+            template <class Op, class First, class Second, class Third>
+            struct expr<Op, First, Second, Third> {
+                First m_first;
+                Second m_second;
+                Third m_third;
+            };
+
             namespace expressions {
                 template <class>
                 struct is_expr : std::false_type {};
@@ -64,16 +71,6 @@ namespace gridtools {
                     GT_FUNCTION GT_CONSTEXPR decltype(auto) apply_eval(Eval &&eval, Arg arg) {
                         return wstd::forward<Eval>(eval)(wstd::move(arg));
                     }
-
-                    template <class Eval, class Op, class Arg>
-                    GT_FUNCTION GT_CONSTEXPR auto value(Eval &&eval, expr<Op, Arg> arg) {
-                        return Op()(wstd::forward<Eval>(eval)(wstd::move(arg.m_arg)));
-                    }
-
-                    template <class Eval, class Op, class Lhs, class Rhs>
-                    GT_FUNCTION GT_CONSTEXPR auto value(Eval &&eval, expr<Op, Lhs, Rhs> arg) {
-                        return Op()(apply_eval(eval, wstd::move(arg.m_lhs)), apply_eval(eval, wstd::move(arg.m_rhs)));
-                    }
                 } // namespace evaluation
             }     // namespace expressions
         }         // namespace cartesian
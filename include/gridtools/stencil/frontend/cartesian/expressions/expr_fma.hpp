@@ -0,0 +1,69 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+
+#include "../../../../common/generic_metafunctions/utility.hpp"
+#include "../../../../common/gt_math.hpp"
+#include "../../../../common/host_device.hpp"
+#include "expr_base.hpp"
+
+namespace gridtools {
+    namespace stencil {
+        namespace cartesian {
+            namespace expressions {
+                namespace fma_impl_ {
+                    // `std::fma` is a library call if the target has no fused multiply-add instruction
+                    template <class T>
+                    struct has_fast_fma : std::false_type {};
+#if defined(__CUDA_ARCH__) || defined(FP_FAST_FMAF)
+                    template <>
+                    struct has_fast_fma<float> : std::true_type {};
+#endif
+#if defined(__CUDA_ARCH__) || defined(FP_FAST_FMA)
+                    template <>
+                    struct has_fast_fma<double> : std::true_type {};
+#endif
+                } // namespace fma_impl_
+
+                /**
+                 *  `a * b + c`, computed with a single rounding if the hardware supports it.
+                 */
+                struct fma_f {
+                    template <class A,
+                        class B,
+                        class C,
+                        class T = decltype(std::declval<A>() * std::declval<B>() + std::declval<C>()),
+                        std::enable_if_t<fma_impl_::has_fast_fma<T>::value, int> = 0>
+                    GT_FUNCTION auto operator()(A const &a, B const &b, C const &c) const {
+                        return math::fma(static_cast<T>(a), static_cast<T>(b), static_cast<T>(c));
+                    }
+
+                    template <class A,
+                        class B,
+                        class C,
+                        class T = decltype(std::declval<A>() * std::declval<B>() + std::declval<C>()),
+                        std::enable_if_t<!fma_impl_::has_fast_fma<T>::value, int> = 0>
+                    GT_FUNCTION GT_CONSTEXPR auto operator()(A const &a, B const &b, C const &c) const {
+                        return a * b + c;
+                    }
+                };
+
+                template <class A, class B, class C>
+                GT_FUNCTION GT_CONSTEXPR auto fma(A a, B b, C c) -> decltype(make_expr(fma_f(), A(), B(), C())) {
+                    return make_expr(fma_f(), a, b, c);
+                }
+            } // namespace expressions
+        }     // namespace cartesian
+    }         // namespace stencil
+} // namespace gridtools
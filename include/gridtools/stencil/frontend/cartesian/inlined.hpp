@@ -0,0 +1,404 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <type_traits>
+
+#include "../../../common/defs.hpp"
+#include "../../../common/host_device.hpp"
+#include "../../../common/tuple.hpp"
+#include "../../../meta.hpp"
+#include "../../common/extent.hpp"
+#include "../../common/intent.hpp"
+#include "../../core/esf.hpp"
+#include "../../core/esf_metafunctions.hpp"
+#include "../../core/functor_metafunctions.hpp"
+#include "../../core/is_tmp_arg.hpp"
+#include "../../core/mss.hpp"
+#include "accessor.hpp"
+#include "expressions/evaluation.hpp"
+#include "stencil_functions.hpp"
+#include "tmp_arg.hpp"
+
+/**
+ *  @file
+ *  Inlining of temporaries: `execute_parallel().stage(...)...inlined(tmp)`.
+ *
+ *  The stage that produces an inlined temporary is removed from the specification and every stage that reads the
+ *  temporary is replaced by an `inlined_functor` that evaluates the producer on the fly, at the offset of each access
+ *  to the temporary. The arguments of the producer become arguments of the consumer with the extents shifted by the
+ *  extent of the access to the temporary. The temporary is not allocated anymore.
+ *
+ *  Restrictions:
+ *    - the producer is the only stage that writes the temporary and it has exactly one output;
+ *    - the inputs of the producer are not written by any stage of the specification;
+ *    - if the temporary is accessed with vertical offsets, the producer has the same apply overload on all levels;
+ *    - the temporary is read in the pass where it is inlined and not used by any other pass.
+ */
+namespace gridtools {
+    namespace stencil {
+        namespace cartesian {
+            namespace inlined_impl_ {
+                template <class List, class T>
+                using contains = bool_constant<(meta::find<List, T>::value < meta::length<List>::value)>;
+
+                template <class Set>
+                struct is_in {
+                    template <class T>
+                    using apply = contains<Set, T>;
+                };
+
+                template <class List, class Set>
+                using intersects =
+                    bool_constant<meta::length<meta::filter<is_in<Set>::template apply, List>>::value != 0>;
+
+                template <class T>
+                struct is_not {
+                    template <class U>
+                    using apply = bool_constant<!std::is_same<T, U>::value>;
+                };
+
+                template <class Arg>
+                struct has_arg {
+                    template <class Item>
+                    using apply = std::is_same<meta::first<Item>, Arg>;
+                };
+
+                template <class Item>
+                using is_not_out_item = bool_constant<meta::second<Item>::intent_v != intent::inout>;
+
+                template <class Param>
+                using is_out_param = bool_constant<Param::intent_v == intent::inout>;
+
+                template <class>
+                struct accessor_dim;
+
+                template <uint_t Id, intent Intent, class Extent, size_t Dim, class Seq>
+                struct accessor_dim<accessor<Id, Intent, Extent, Dim, Seq>> : std::integral_constant<size_t, Dim> {};
+
+                constexpr size_t max_dim() { return 0; }
+
+                template <class... Ts>
+                constexpr size_t max_dim(size_t dim, Ts... dims) {
+                    return dim > max_dim(dims...) ? dim : max_dim(dims...);
+                }
+
+                template <bool IsInout, class Extent, size_t Dim>
+                struct usage {
+                    static constexpr bool is_inout = IsInout;
+                    using extent_t = Extent;
+                    static constexpr size_t dim = Dim;
+                };
+
+                template <class Item, class Param = meta::second<Item>>
+                using consumer_usage = usage<Param::intent_v == intent::inout,
+                    typename Param::extent_t,
+                    accessor_dim<Param>::value>;
+
+                template <class TmpExtent, size_t TmpDim>
+                struct producer_usage_f {
+                    template <class Item, class Param = meta::second<Item>>
+                    using apply = usage<false,
+                        sum_extent<typename Param::extent_t, TmpExtent>,
+                        max_dim(accessor_dim<Param>::value, TmpDim)>;
+                };
+
+                template <class Usage>
+                using usage_extent = typename Usage::extent_t;
+
+                template <class>
+                struct max_usage_dim;
+
+                template <class... Usages>
+                struct max_usage_dim<meta::list<Usages...>>
+                    : std::integral_constant<size_t, max_dim(Usages::dim...)> {};
+
+                template <class Index, class Usages>
+                struct make_param;
+
+                template <class Index, class... Usages>
+                struct make_param<Index, meta::list<Usages...>> {
+                    using extent_t = enclosing_extent<typename Usages::extent_t...>;
+                    using type = accessor<Index::value,
+                        disjunction<bool_constant<Usages::is_inout>...>::value ? intent::inout : intent::in,
+                        extent_t,
+                        max_dim(accessor_impl_::minimal_dim<extent_t>::value,
+                            max_usage_dim<meta::list<Usages...>>::value)>;
+                };
+
+                template <class W>
+                struct make_param_f {
+                    template <class Index, class Arg>
+                    using apply = typename make_param<Index,
+                        meta::concat<meta::transform<consumer_usage,
+                                         meta::filter<has_arg<Arg>::template apply, typename W::consumer_items_t>>,
+                            meta::transform<W::producer_usage_t::template apply,
+                                meta::filter<has_arg<Arg>::template apply, typename W::producer_items_t>>>>::type;
+                };
+
+                template <class W, class Arg>
+                using param_of = meta::at_c<typename W::param_list, meta::find<typename W::args_t, Arg>::value>;
+
+                template <class Res, class Accessor, class Offsets>
+                GT_FUNCTION Res shift(Accessor acc, Offsets const &offsets) {
+                    return call_interfaces_impl_::sum_offsets<Res>(wstd::move(acc), offsets);
+                }
+
+                template <class W, class Eval, class TmpAccessor>
+                struct producer_evaluator {
+                    using data_t = typename W::tmp_t::data_t;
+
+                    Eval &m_eval;
+                    TmpAccessor const &m_offsets;
+                    data_t &m_res;
+
+                    template <class Accessor,
+                        std::enable_if_t<is_accessor<Accessor>::value &&
+                                             Accessor::index_t::value == W::out_index_t::value,
+                            int> = 0>
+                    GT_FUNCTION data_t &operator()(Accessor) const {
+                        return m_res;
+                    }
+
+                    template <class Accessor,
+                        class Arg = meta::at<typename W::producer_args_t, typename Accessor::index_t>,
+                        std::enable_if_t<is_accessor<Accessor>::value &&
+                                             Accessor::index_t::value != W::out_index_t::value,
+                            int> = 0>
+                    GT_FUNCTION decltype(auto) operator()(Accessor acc) const {
+                        return m_eval(shift<param_of<W, Arg>>(wstd::move(acc), m_offsets));
+                    }
+
+                    template <class Op, class... Ts>
+                    GT_FUNCTION auto operator()(expr<Op, Ts...> arg) const {
+                        return expressions::evaluation::value(*this, wstd::move(arg));
+                    }
+                };
+
+                template <class W, class Pf, class Eval>
+                struct consumer_evaluator {
+                    Eval &m_eval;
+
+                    template <class Accessor,
+                        class Arg = meta::at<typename W::consumer_args_t, typename Accessor::index_t>,
+                        std::enable_if_t<is_accessor<Accessor>::value && !std::is_same<Arg, typename W::tmp_t>::value,
+                            int> = 0>
+                    GT_FUNCTION decltype(auto) operator()(Accessor acc) const {
+                        return m_eval(shift<param_of<W, Arg>>(wstd::move(acc), tuple<>()));
+                    }
+
+                    // the producer is evaluated at the offset of the access
+                    template <class Accessor,
+                        class Arg = meta::at<typename W::consumer_args_t, typename Accessor::index_t>,
+                        std::enable_if_t<is_accessor<Accessor>::value && std::is_same<Arg, typename W::tmp_t>::value,
+                            int> = 0>
+                    GT_FUNCTION typename W::tmp_t::data_t operator()(Accessor acc) const {
+                        typename W::tmp_t::data_t res;
+                        producer_evaluator<W, Eval, Accessor> eval{m_eval, acc, res};
+                        Pf::template apply<producer_evaluator<W, Eval, Accessor> &>(eval);
+                        return res;
+                    }
+
+                    template <class Op, class... Ts>
+                    GT_FUNCTION auto operator()(expr<Op, Ts...> arg) const {
+                        return expressions::evaluation::value(*this, wstd::move(arg));
+                    }
+                };
+
+                template <class W, class Cf, class Pf>
+                struct level_functor {
+                    using param_list = typename W::param_list;
+
+                    template <class Eval>
+                    static GT_FUNCTION void apply(Eval &&eval) {
+                        consumer_evaluator<W, Pf, std::remove_reference_t<Eval>> consumer_eval{eval};
+                        Cf::template apply<consumer_evaluator<W, Pf, std::remove_reference_t<Eval>> &>(consumer_eval);
+                    }
+                };
+
+                template <class W, class CItem, class PItem>
+                struct make_item;
+
+                template <class W, class Key, class PItem>
+                struct make_item<W, meta::list<Key>, PItem> {
+                    using type = meta::list<Key>;
+                };
+
+                template <class W, class Key, class Cf>
+                struct make_item<W, meta::list<Key, Cf>, meta::list<Key>> {
+                    static_assert(sizeof(W) == 0,
+                        "The producer of an inlined temporary has no apply overload on a level where the temporary is "
+                        "read.");
+                };
+
+                template <class W, class Key, class Cf, class Pf>
+                struct make_item<W, meta::list<Key, Cf>, meta::list<Key, Pf>> {
+                    using type = meta::list<Key, level_functor<W, Cf, Pf>>;
+                };
+
+                template <class W>
+                struct make_item_f {
+                    template <class CItem, class PItem>
+                    using apply = typename make_item<W, CItem, PItem>::type;
+                };
+
+                template <class W, class Interval>
+                struct make_functor_map {
+                    static_assert(core::check_valid_functor<typename W::consumer_t, Interval>::value,
+                        "Invalid stencil operator detected.");
+                    static_assert(core::check_valid_functor<typename W::producer_t, Interval>::value,
+                        "Invalid stencil operator detected.");
+
+                    using consumer_map_t = core::esf_functor_map<typename W::consumer_t, Interval>;
+                    using producer_map_t = core::esf_functor_map<typename W::producer_t, Interval>;
+
+                    static_assert((W::tmp_extent_t::kminus::value == 0 && W::tmp_extent_t::kplus::value == 0) ||
+                                      meta::length<meta::dedup<producer_map_t>>::value == 1 ||
+                                      meta::length<meta::dedup<meta::transform<meta::pop_front, producer_map_t>>>::
+                                              value == 1,
+                        "An inlined temporary that is accessed with vertical offsets should be produced by the same "
+                        "apply overload on all levels.");
+
+                    using type = meta::transform<make_item_f<W>::template apply, consumer_map_t, producer_map_t>;
+                };
+
+                /*
+                 *  A consumer stage with the producer of the temporary `Tmp` evaluated in place.
+                 */
+                template <class Consumer, class Producer, class Tmp, class ConsumerArgs, class ProducerArgs>
+                struct inlined_functor {
+                    using consumer_t = Consumer;
+                    using producer_t = Producer;
+                    using tmp_t = Tmp;
+                    using consumer_args_t = ConsumerArgs;
+                    using producer_args_t = ProducerArgs;
+
+                    using producer_out_params_t = meta::filter<is_out_param, typename Producer::param_list>;
+                    static_assert(meta::length<producer_out_params_t>::value == 1,
+                        "The producer of an inlined temporary should have exactly one output.");
+                    using out_index_t = typename meta::first<producer_out_params_t>::index_t;
+                    static_assert(std::is_same<meta::at<ProducerArgs, out_index_t>, Tmp>::value,
+                        "The output of the producer of an inlined temporary should be the temporary.");
+
+                    using consumer_items_t = meta::zip<ConsumerArgs, typename Consumer::param_list>;
+                    using producer_items_t =
+                        meta::filter<is_not_out_item, meta::zip<ProducerArgs, typename Producer::param_list>>;
+
+                    using tmp_items_t = meta::filter<has_arg<Tmp>::template apply, consumer_items_t>;
+                    static_assert(
+                        meta::length<meta::filter<is_not_out_item, tmp_items_t>>::value ==
+                            meta::length<tmp_items_t>::value,
+                        "An inlined temporary can not be written by its consumers.");
+                    using tmp_usages_t = meta::transform<consumer_usage, tmp_items_t>;
+                    using tmp_extent_t = meta::rename<enclosing_extent, meta::transform<usage_extent, tmp_usages_t>>;
+                    using producer_usage_t = producer_usage_f<tmp_extent_t, max_usage_dim<tmp_usages_t>::value>;
+
+                    using args_t = meta::dedup<meta::concat<meta::filter<is_not<Tmp>::template apply, ConsumerArgs>,
+                        meta::transform<meta::first, producer_items_t>>>;
+
+                    using param_list = meta::transform<make_param_f<inlined_functor>::template apply,
+                        meta::make_indices_for<args_t>,
+                        args_t>;
+
+                    using inlined_tmps_t = meta::dedup<
+                        meta::concat<meta::list<Tmp>, core::inlined_tmps<Consumer>, core::inlined_tmps<Producer>>>;
+
+                    template <class Interval>
+                    using functor_map = typename make_functor_map<inlined_functor, Interval>::type;
+                };
+
+                template <class Tmp>
+                struct reads {
+                    template <class Esf>
+                    using apply = bool_constant<contains<typename Esf::args_t, Tmp>::value &&
+                                                !contains<core::esf_get_w_args_per_functor<Esf>, Tmp>::value>;
+                };
+
+                template <class Tmp>
+                struct writes {
+                    template <class Esf>
+                    using apply = contains<core::esf_get_w_args_per_functor<Esf>, Tmp>;
+                };
+
+                template <class Tmp>
+                struct is_not_cached {
+                    template <class Cache>
+                    using apply = bool_constant<!std::is_same<typename Cache::plh_t, Tmp>::value>;
+                };
+
+                template <class Esf, class Producer, class Tmp, class = void>
+                struct inline_esf {
+                    using type = Esf;
+                };
+
+                template <class F, class Args, class Extent, class PF, class PArgs, class PExtent, class Tmp>
+                struct inline_esf<core::esf_descriptor<F, Args, Extent>,
+                    core::esf_descriptor<PF, PArgs, PExtent>,
+                    Tmp,
+                    std::enable_if_t<contains<Args, Tmp>::value>> {
+                    using functor_t = inlined_functor<F, PF, Tmp, Args, PArgs>;
+                    using type = core::esf_descriptor<functor_t, typename functor_t::args_t, Extent>;
+                };
+
+                template <class Mss, class Tmp>
+                struct inline_tmp;
+
+                template <class ExecutionType, class Esfs, class Caches, class Tmp>
+                struct inline_tmp<core::mss_descriptor<ExecutionType, Esfs, Caches>, Tmp> {
+                    using producers_t = meta::filter<writes<Tmp>::template apply, Esfs>;
+                    static_assert(meta::length<producers_t>::value == 1,
+                        "An inlined temporary should be written by exactly one stage.");
+                    using producer_t = meta::first<producers_t>;
+
+                    using first_reader_t =
+                        meta::find<meta::transform<reads<Tmp>::template apply, Esfs>, std::true_type>;
+                    static_assert(first_reader_t::value < meta::length<Esfs>::value,
+                        "An inlined temporary should be read in the pass where it is inlined.");
+                    static_assert(meta::find<Esfs, producer_t>::value < first_reader_t::value,
+                        "An inlined temporary can not be read before it is computed.");
+
+                    using producer_in_args_t = meta::transform<meta::first,
+                        meta::filter<is_not_out_item,
+                            meta::zip<typename producer_t::args_t, core::esf_param_list<producer_t>>>>;
+                    static_assert(!intersects<producer_in_args_t, core::compute_readwrite_args<Esfs>>::value,
+                        "The inputs of the producer of an inlined temporary can not be written in the same "
+                        "computation.");
+
+                    template <class Esf>
+                    using inline_esf_f = typename inline_esf<Esf, producer_t, Tmp>::type;
+
+                    using esfs_t =
+                        meta::transform<inline_esf_f, meta::filter<is_not<producer_t>::template apply, Esfs>>;
+                    using caches_t = meta::filter<is_not_cached<Tmp>::template apply, Caches>;
+
+                    using type = core::mss_descriptor<ExecutionType, esfs_t, caches_t>;
+                };
+
+                template <class Mss, class... Tmps>
+                struct inline_tmps_f {
+                    using type = Mss;
+                };
+
+                template <class Mss, class Tmp, class... Tmps>
+                struct inline_tmps_f<Mss, Tmp, Tmps...>
+                    : inline_tmps_f<typename inline_tmp<Mss, Tmp>::type, Tmps...> {};
+            } // namespace inlined_impl_
+
+            /**
+             *  The hook for `spec::inlined(tmps...)`. Only used in unevaluated context.
+             */
+            template <class ExecutionType, class Esfs, class Caches, size_t... Is, class... Datas>
+            typename inlined_impl_::inline_tmps_f<core::mss_descriptor<ExecutionType, Esfs, Caches>,
+                tmp_arg<Is, Datas>...>::type
+            inline_tmps(core::mss_descriptor<ExecutionType, Esfs, Caches>, tmp_arg<Is, Datas>...);
+        }     // namespace cartesian
+    }         // namespace stencil
+} // namespace gridtools
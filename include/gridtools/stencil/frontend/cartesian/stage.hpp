@@ -36,7 +36,7 @@
 #include "../../../sid/multi_shift.hpp"
 #include "../../common/extent.hpp"
 #include "../../common/intent.hpp"
-#include "expressions/expr_base.hpp"
+#include "expressions/evaluation.hpp"
 
 namespace gridtools {
     namespace stencil {
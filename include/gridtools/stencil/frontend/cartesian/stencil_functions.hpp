@@ -19,7 +19,7 @@
 #include "../../common/dim.hpp"
 #include "../../core/interval.hpp"
 #include "accessor.hpp"
-#include "expressions/expr_base.hpp"
+#include "expressions/evaluation.hpp"
 
 namespace gridtools {
     namespace stencil {
@@ -0,0 +1,386 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <type_traits>
+
+#include "../../../common/defs.hpp"
+#include "../../../common/host_device.hpp"
+#include "../../../common/integral_constant.hpp"
+#include "../../../meta.hpp"
+#include "../../common/caches.hpp"
+#include "../../common/extent.hpp"
+#include "../make_param_list.hpp"
+#include "../run.hpp"
+#include "accessor.hpp"
+
+/**
+ *  @file
+ *  Batched solvers of banded linear systems along the vertical axis, one system per column:
+ *
+ *    auto spec = [](auto inf, auto diag, auto sup, auto rhs, auto out) {
+ *        return solve_tridiagonal<double, axis_t::full_interval>(inf, diag, sup, rhs, out);
+ *    };
+ *
+ *  The solvers return multi-pass specifications that can be combined with other ones by `fuse`. The row `k` of a
+ *  system reads `inf(k) x(k - 1) + diag(k) x(k) + sup(k) x(k + 1) = rhs(k)`, the coefficients that point outside of
+ *  the interval are not accessed (apart from the periodic case, where they couple the first and the last level). The
+ *  elimination is done without pivoting, the systems are expected to be diagonally dominant.
+ *
+ *  The modified coefficients are kept in temporaries of the element type `Float`. The blocked CPU backends allocate
+ *  them per block and run the forward and the backward sweeps of a block one after another, vectorized along i,
+ *  while the coefficients are still in cache.
+ */
+namespace gridtools {
+    namespace stencil {
+        namespace cartesian {
+            namespace vertical_solvers_impl_ {
+                /*
+                 *  The scratch fields of a solver. They are identified by the output placeholder, therefore several
+                 *  solvers with distinct outputs can be fused.
+                 */
+                template <class Tag, class Out, class Data>
+                struct scratch {
+                    using data_t = Data;
+                    using num_colors_t = integral_constant<int_t, 1>;
+                    using tmp_tag = std::true_type;
+                };
+
+                /*
+                 *  The scratch fields of `solve_tridiagonal` are marked as such, backends may recognize the solve by
+                 *  the marker and use a different algorithm (see `be_api::tridiagonal_system`).
+                 */
+                template <class Tag, class Out, class Data, class Interval, class Inf, class Diag, class Sup, class Rhs>
+                struct tridiagonal_scratch : scratch<Tag, Out, Data> {
+                    using tridiagonal_system_t = meta::list<Data, Interval, Inf, Diag, Sup, Rhs, Out>;
+                };
+
+                struct c_tag;
+                struct d_tag;
+                struct dz_tag;
+                struct z_tag;
+                struct corner_tag;
+                struct y_last_tag;
+                struct z_last_tag;
+                struct fact_tag;
+                struct delta_tag;
+
+                template <class Interval>
+                struct tridiagonal_forward {
+                    using inf = in_accessor<0>;
+                    using diag = in_accessor<1>;
+                    using sup = in_accessor<2>;
+                    using rhs = in_accessor<3>;
+                    using c = inout_accessor<4, extent<0, 0, 0, 0, -1, 0>>;
+                    using d = inout_accessor<5, extent<0, 0, 0, 0, -1, 0>>;
+                    using param_list = make_param_list<inf, diag, sup, rhs, c, d>;
+
+                    template <class Eval>
+                    GT_FUNCTION static void apply(Eval &&eval, typename Interval::first_level) {
+                        using float_t = std::decay_t<decltype(eval(c()))>;
+                        float_t div = float_t(1) / eval(diag());
+                        eval(c()) = eval(sup()) * div;
+                        eval(d()) = eval(rhs()) * div;
+                    }
+
+                    template <class Eval>
+                    GT_FUNCTION static void apply(Eval &&eval, typename Interval::template modify<1, 0>) {
+                        using float_t = std::decay_t<decltype(eval(c()))>;
+                        float_t div = float_t(1) / (eval(diag()) - eval(c(0, 0, -1)) * eval(inf()));
+                        eval(c()) = eval(sup()) * div;
+                        eval(d()) = (eval(rhs()) - eval(inf()) * eval(d(0, 0, -1))) * div;
+                    }
+                };
+
+                template <class Interval>
+                struct tridiagonal_backward {
+                    using out = inout_accessor<0, extent<0, 0, 0, 0, 0, 1>>;
+                    using c = in_accessor<1>;
+                    using d = in_accessor<2>;
+                    using param_list = make_param_list<out, c, d>;
+
+                    template <class Eval>
+                    GT_FUNCTION static void apply(Eval &&eval, typename Interval::template modify<0, -1>) {
+                        eval(out()) = eval(d()) - eval(c()) * eval(out(0, 0, 1));
+                    }
+
+                    template <class Eval>
+                    GT_FUNCTION static void apply(Eval &&eval, typename Interval::last_level) {
+                        eval(out()) = eval(d());
+                    }
+                };
+
+                /*
+                 *  Sherman-Morrison: the corner coefficients `inf` at the first and `sup` at the last level are moved
+                 *  to a rank one correction `u v^T` with `u = (gamma, 0, ..., 0, sup)` and
+                 *  `v = (1, 0, ..., 0, inf / gamma)`, where `gamma = -diag` at the first level. The remaining
+                 *  tridiagonal system is solved for `y` and `z` with the right hand sides `rhs` and `u` at once and
+                 *  `x = y - v.y / (1 + v.z) z`.
+                 */
+                template <class Interval>
+                struct periodic_forward {
+                    using inf = in_accessor<0>;
+                    using diag = in_accessor<1>;
+                    using sup = in_accessor<2>;
+                    using rhs = in_accessor<3>;
+                    using c = inout_accessor<4, extent<0, 0, 0, 0, -1, 0>>;
+                    using dy = inout_accessor<5, extent<0, 0, 0, 0, -1, 0>>;
+                    using dz = inout_accessor<6, extent<0, 0, 0, 0, -1, 0>>;
+                    using corner = inout_accessor<7, extent<0, 0, 0, 0, -1, 0>>;
+                    using param_list = make_param_list<inf, diag, sup, rhs, c, dy, dz, corner>;
+
+                    template <class Eval>
+                    GT_FUNCTION static void apply(Eval &&eval, typename Interval::first_level) {
+                        using float_t = std::decay_t<decltype(eval(c()))>;
+                        float_t gamma = -eval(diag());
+                        eval(corner()) = eval(inf()) / gamma;
+                        float_t div = float_t(1) / (eval(diag()) - gamma);
+                        eval(c()) = eval(sup()) * div;
+                        eval(dy()) = eval(rhs()) * div;
+                        eval(dz()) = gamma * div;
+                    }
+
+                    template <class Eval>
+                    GT_FUNCTION static void apply(Eval &&eval, typename Interval::template modify<1, -1>) {
+                        using float_t = std::decay_t<decltype(eval(c()))>;
+                        eval(corner()) = eval(corner(0, 0, -1));
+                        float_t div = float_t(1) / (eval(diag()) - eval(c(0, 0, -1)) * eval(inf()));
+                        eval(c()) = eval(sup()) * div;
+                        eval(dy()) = (eval(rhs()) - eval(inf()) * eval(dy(0, 0, -1))) * div;
+                        eval(dz()) = -eval(inf()) * eval(dz(0, 0, -1)) * div;
+                    }
+
+                    template <class Eval>
+                    GT_FUNCTION static void apply(Eval &&eval, typename Interval::last_level) {
+                        using float_t = std::decay_t<decltype(eval(c()))>;
+                        eval(corner()) = eval(corner(0, 0, -1));
+                        float_t div = float_t(1) /
+                                      (eval(diag()) - eval(sup()) * eval(corner()) - eval(c(0, 0, -1)) * eval(inf()));
+                        eval(dy()) = (eval(rhs()) - eval(inf()) * eval(dy(0, 0, -1))) * div;
+                        eval(dz()) = (eval(sup()) - eval(inf()) * eval(dz(0, 0, -1))) * div;
+                    }
+                };
+
+                template <class Interval>
+                struct periodic_backward {
+                    using out = inout_accessor<0, extent<0, 0, 0, 0, 0, 1>>;
+                    using z = inout_accessor<1, extent<0, 0, 0, 0, 0, 1>>;
+                    using y_last = inout_accessor<2, extent<0, 0, 0, 0, 0, 1>>;
+                    using z_last = inout_accessor<3, extent<0, 0, 0, 0, 0, 1>>;
+                    using c = in_accessor<4>;
+                    using dy = in_accessor<5>;
+                    using dz = in_accessor<6>;
+                    using param_list = make_param_list<out, z, y_last, z_last, c, dy, dz>;
+
+                    template <class Eval>
+                    GT_FUNCTION static void apply(Eval &&eval, typename Interval::template modify<0, -1>) {
+                        eval(out()) = eval(dy()) - eval(c()) * eval(out(0, 0, 1));
+                        eval(z()) = eval(dz()) - eval(c()) * eval(z(0, 0, 1));
+                        eval(y_last()) = eval(y_last(0, 0, 1));
+                        eval(z_last()) = eval(z_last(0, 0, 1));
+                    }
+
+                    template <class Eval>
+                    GT_FUNCTION static void apply(Eval &&eval, typename Interval::last_level) {
+                        eval(out()) = eval(dy());
+                        eval(z()) = eval(dz());
+                        eval(y_last()) = eval(dy());
+                        eval(z_last()) = eval(dz());
+                    }
+                };
+
+                template <class Interval>
+                struct periodic_correction {
+                    using out = inout_accessor<0>;
+                    using fact = inout_accessor<1, extent<0, 0, 0, 0, -1, 0>>;
+                    using z = in_accessor<2>;
+                    using corner = in_accessor<3>;
+                    using y_last = in_accessor<4>;
+                    using z_last = in_accessor<5>;
+                    using param_list = make_param_list<out, fact, z, corner, y_last, z_last>;
+
+                    template <class Eval>
+                    GT_FUNCTION static void apply(Eval &&eval, typename Interval::first_level) {
+                        using float_t = std::decay_t<decltype(eval(fact()))>;
+                        eval(fact()) = (eval(out()) + eval(corner()) * eval(y_last())) /
+                                       (float_t(1) + eval(z()) + eval(corner()) * eval(z_last()));
+                        eval(out()) -= eval(fact()) * eval(z());
+                    }
+
+                    template <class Eval>
+                    GT_FUNCTION static void apply(Eval &&eval, typename Interval::template modify<1, 0>) {
+                        eval(fact()) = eval(fact(0, 0, -1));
+                        eval(out()) -= eval(fact()) * eval(z());
+                    }
+                };
+
+                /*
+                 *  The row `k` is reduced to `x(k) + c(k) x(k + 1) + delta(k) x(k + 2) = d(k)` by substituting the
+                 *  two previous reduced rows.
+                 */
+                template <class Interval>
+                struct pentadiagonal_forward {
+                    using inf2 = in_accessor<0>;
+                    using inf = in_accessor<1>;
+                    using diag = in_accessor<2>;
+                    using sup = in_accessor<3>;
+                    using sup2 = in_accessor<4>;
+                    using rhs = in_accessor<5>;
+                    using c = inout_accessor<6, extent<0, 0, 0, 0, -2, 0>>;
+                    using delta = inout_accessor<7, extent<0, 0, 0, 0, -2, 0>>;
+                    using d = inout_accessor<8, extent<0, 0, 0, 0, -2, 0>>;
+                    using param_list = make_param_list<inf2, inf, diag, sup, sup2, rhs, c, delta, d>;
+
+                    template <class Eval>
+                    GT_FUNCTION static void apply(Eval &&eval, typename Interval::first_level) {
+                        using float_t = std::decay_t<decltype(eval(c()))>;
+                        float_t div = float_t(1) / eval(diag());
+                        eval(c()) = eval(sup()) * div;
+                        eval(delta()) = eval(sup2()) * div;
+                        eval(d()) = eval(rhs()) * div;
+                    }
+
+                    template <class Eval>
+                    GT_FUNCTION static void apply(Eval &&eval, typename Interval::first_level::template shift<1>) {
+                        using float_t = std::decay_t<decltype(eval(c()))>;
+                        float_t alpha = eval(inf());
+                        float_t div = float_t(1) / (eval(diag()) - alpha * eval(c(0, 0, -1)));
+                        eval(c()) = (eval(sup()) - alpha * eval(delta(0, 0, -1))) * div;
+                        eval(delta()) = eval(sup2()) * div;
+                        eval(d()) = (eval(rhs()) - alpha * eval(d(0, 0, -1))) * div;
+                    }
+
+                    template <class Eval>
+                    GT_FUNCTION static void apply(Eval &&eval, typename Interval::template modify<2, 0>) {
+                        using float_t = std::decay_t<decltype(eval(c()))>;
+                        float_t alpha = eval(inf()) - eval(inf2()) * eval(c(0, 0, -2));
+                        float_t div = float_t(1) /
+                                      (eval(diag()) - eval(inf2()) * eval(delta(0, 0, -2)) - alpha * eval(c(0, 0, -1)));
+                        eval(c()) = (eval(sup()) - alpha * eval(delta(0, 0, -1))) * div;
+                        eval(delta()) = eval(sup2()) * div;
+                        eval(d()) = (eval(rhs()) - eval(inf2()) * eval(d(0, 0, -2)) - alpha * eval(d(0, 0, -1))) * div;
+                    }
+                };
+
+                template <class Interval>
+                struct pentadiagonal_backward {
+                    using out = inout_accessor<0, extent<0, 0, 0, 0, 0, 2>>;
+                    using c = in_accessor<1>;
+                    using delta = in_accessor<2>;
+                    using d = in_accessor<3>;
+                    using param_list = make_param_list<out, c, delta, d>;
+
+                    template <class Eval>
+                    GT_FUNCTION static void apply(Eval &&eval, typename Interval::template modify<0, -2>) {
+                        eval(out()) = eval(d()) - eval(c()) * eval(out(0, 0, 1)) - eval(delta()) * eval(out(0, 0, 2));
+                    }
+
+                    template <class Eval>
+                    GT_FUNCTION static void apply(Eval &&eval, typename Interval::last_level::template shift<-1>) {
+                        eval(out()) = eval(d()) - eval(c()) * eval(out(0, 0, 1));
+                    }
+
+                    template <class Eval>
+                    GT_FUNCTION static void apply(Eval &&eval, typename Interval::last_level) {
+                        eval(out()) = eval(d());
+                    }
+                };
+
+                /**
+                 *  Solves the tridiagonal systems within `Interval` with the Thomas algorithm. The interval should
+                 *  have at least two levels. The `cpu_ifirst` backend switches to parallel cyclic reduction if there
+                 *  are fewer column blocks than threads.
+                 */
+                template <class Float, class Interval, class Inf, class Diag, class Sup, class Rhs, class Out>
+                constexpr auto solve_tridiagonal(Inf inf, Diag diag, Sup sup, Rhs rhs, Out out) {
+                    using c_t = tridiagonal_scratch<c_tag, Out, Float, Interval, Inf, Diag, Sup, Rhs>;
+                    using d_t = tridiagonal_scratch<d_tag, Out, Float, Interval, Inf, Diag, Sup, Rhs>;
+                    return multi_pass(execute_forward()
+                                          .k_cached(cache_io_policy::flush(), c_t(), d_t())
+                                          .stage(tridiagonal_forward<Interval>(), inf, diag, sup, rhs, c_t(), d_t()),
+                        execute_backward().stage(tridiagonal_backward<Interval>(), out, c_t(), d_t()));
+                }
+
+                /**
+                 *  Solves the periodic tridiagonal systems within `Interval`: `inf` at the first level couples to
+                 *  the last level and `sup` at the last level couples to the first level. The interval should have
+                 *  at least three levels.
+                 */
+                template <class Float, class Interval, class Inf, class Diag, class Sup, class Rhs, class Out>
+                constexpr auto solve_periodic_tridiagonal(Inf inf, Diag diag, Sup sup, Rhs rhs, Out out) {
+                    using c_t = scratch<c_tag, Out, Float>;
+                    using dy_t = scratch<d_tag, Out, Float>;
+                    using dz_t = scratch<dz_tag, Out, Float>;
+                    using z_t = scratch<z_tag, Out, Float>;
+                    using corner_t = scratch<corner_tag, Out, Float>;
+                    using y_last_t = scratch<y_last_tag, Out, Float>;
+                    using z_last_t = scratch<z_last_tag, Out, Float>;
+                    using fact_t = scratch<fact_tag, Out, Float>;
+                    return multi_pass(
+                        execute_forward()
+                            .k_cached(cache_io_policy::flush(), c_t(), dy_t(), dz_t(), corner_t())
+                            .stage(periodic_forward<Interval>(),
+                                inf,
+                                diag,
+                                sup,
+                                rhs,
+                                c_t(),
+                                dy_t(),
+                                dz_t(),
+                                corner_t()),
+                        execute_backward().stage(
+                            periodic_backward<Interval>(), out, z_t(), y_last_t(), z_last_t(), c_t(), dy_t(), dz_t()),
+                        execute_forward().k_cached(fact_t()).stage(
+                            periodic_correction<Interval>(), out, fact_t(), z_t(), corner_t(), y_last_t(), z_last_t()));
+                }
+
+                /**
+                 *  Solves the pentadiagonal systems within `Interval`, the row `k` reads
+                 *  `inf2(k) x(k - 2) + inf(k) x(k - 1) + diag(k) x(k) + sup(k) x(k + 1) + sup2(k) x(k + 2) = rhs(k)`.
+                 *  The interval should have at least four levels and an offset limit of at least three.
+                 */
+                template <class Float,
+                    class Interval,
+                    class Inf2,
+                    class Inf,
+                    class Diag,
+                    class Sup,
+                    class Sup2,
+                    class Rhs,
+                    class Out>
+                constexpr auto solve_pentadiagonal(
+                    Inf2 inf2, Inf inf, Diag diag, Sup sup, Sup2 sup2, Rhs rhs, Out out) {
+                    static_assert(Interval::offset_limit >= 3,
+                        "The pentadiagonal solver requires an axis with `axis_config::offset_limit<3>` at least.");
+                    using c_t = scratch<c_tag, Out, Float>;
+                    using delta_t = scratch<delta_tag, Out, Float>;
+                    using d_t = scratch<d_tag, Out, Float>;
+                    return multi_pass(execute_forward()
+                                          .k_cached(cache_io_policy::flush(), c_t(), delta_t(), d_t())
+                                          .stage(pentadiagonal_forward<Interval>(),
+                                              inf2,
+                                              inf,
+                                              diag,
+                                              sup,
+                                              sup2,
+                                              rhs,
+                                              c_t(),
+                                              delta_t(),
+                                              d_t()),
+                        execute_backward().stage(pentadiagonal_backward<Interval>(), out, c_t(), delta_t(), d_t()));
+                }
+            } // namespace vertical_solvers_impl_
+            using vertical_solvers_impl_::solve_pentadiagonal;
+            using vertical_solvers_impl_::solve_periodic_tridiagonal;
+            using vertical_solvers_impl_::solve_tridiagonal;
+        } // namespace cartesian
+    }     // namespace stencil
+} // namespace gridtools
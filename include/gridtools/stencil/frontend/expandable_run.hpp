@@ -146,6 +146,18 @@ namespace gridtools {
                     std::forward<Backend>(be), grid, make_data_store_map<Factor, Is...>(offset, fields...));
             }
 
+            template <class Spec, class Arg, class Field>
+            int mark_if_written(Field const &field) {
+                return frontend_impl_::mark_if_written<Spec, Arg>(field);
+            }
+
+            template <class Spec, class Arg, class T, class A>
+            int mark_if_written(std::vector<T, A> const &fields) {
+                for (auto &&field : fields)
+                    frontend_impl_::mark_if_written<Spec, Arg>(field);
+                return 0;
+            }
+
             template <size_t Factor, class Comp, class Backend, class Grid, class... Fields, size_t... Is>
             auto run_impl(Comp comp, Backend &&be, Grid const &grid, std::index_sequence<Is...>, Fields &&... fields)
                 -> void_t<decltype(comp(make_arg<Is, Fields>()...))> {
@@ -166,6 +178,8 @@ namespace gridtools {
                     expanded_run<Factor, spec_t, Is...>(be, grid, offset, fields...);
                 for (; offset < size; ++offset)
                     expanded_run<1, spec_t, Is...>(be, grid, offset, fields...);
+                using loop_t = int[sizeof...(Is)];
+                (void)loop_t{mark_if_written<spec_t, make_arg<Is, Fields>>(fields)...};
             }
 
             template <size_t, class... Ts>
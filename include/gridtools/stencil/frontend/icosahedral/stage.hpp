@@ -42,12 +42,11 @@
  *   precondition: IteratorDomain should point to the first color.
  *   postcondition: IteratorDomain still points to the first color.
  *
- *   Stage has templated variation of `exec` which accept color number as a first template parameter. This variation
- *   does not iterate on colors; it executes an elementary functor for the given color.
- *   precondition: IteratorDomain should point to the same color as one in exec parameter.
- *
- *   Stage has netsted metafunction contains_color<Color> that evaluates to std::false_type if for the given color
- *   the elementary function is not executed.
+ *   Stage has a variation of `exec` which accepts the color as an integral constant first parameter and nested
+ *   `colors_t` list of them. This variation does not iterate on colors; it executes an elementary functor for the
+ *   given color, with the neighbour offsets of that color known at compile time. Backends can use it to run a
+ *   separate loop per color, which is contiguous in memory with a color-major layout.
+ *   precondition: IteratorDomain should point to the first color, the color offset is applied by the stage.
  *
  *   Note that the Stage is (and should stay) backend independent. The core of gridtools passes stages [split by k-loop
  *   intervals and independent groups] to the backend in the form of compile time only parameters.
@@ -105,14 +104,19 @@ namespace gridtools {
                 template <class Functor, class PlhMap>
                 struct stage {
                     using location_t = typename Functor::location;
+                    using colors_t = meta::make_indices<location_t>;
+
+                    template <class Deref = void, class Color, class Ptr, class Strides>
+                    GT_FUNCTION void operator()(Color, Ptr const &ptr, Strides const &strides) const {
+                        using deref_t = meta::if_<std::is_void<Deref>, default_deref_f, Deref>;
+                        using eval_t = evaluator<Ptr, Strides, PlhMap, deref_t, location_t, Color::value>;
+                        Functor::apply(eval_t{ptr, strides});
+                    }
 
                     template <class Deref = void, class Ptr, class Strides>
                     GT_FUNCTION void operator()(Ptr const &ptr, Strides const &strides) const {
-                        using deref_t = meta::if_<std::is_void<Deref>, default_deref_f, Deref>;
-                        host_device::for_each<meta::make_indices<location_t>>([&](auto color) {
-                            using eval_t = evaluator<Ptr, Strides, PlhMap, deref_t, location_t, decltype(color)::value>;
-                            Functor::apply(eval_t{ptr, strides});
-                        });
+                        host_device::for_each<colors_t>(
+                            [&](auto color) { this->template operator()<Deref>(color, ptr, strides); });
                     }
                 };
             } // namespace stage_impl_
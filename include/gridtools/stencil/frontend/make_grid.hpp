@@ -9,9 +9,16 @@
  */
 #pragma once
 
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #include "../../common/defs.hpp"
 #include "../../common/halo_descriptor.hpp"
 #include "../core/grid.hpp"
+#include "../core/masked_grid.hpp"
 #include "axis.hpp"
 
 namespace gridtools {
@@ -40,5 +47,33 @@ namespace gridtools {
                 (int_t)direction_j.end() + 1 - (int_t)direction_j.begin(),
                 {dk}};
         }
+
+        /**
+         *  Restricts the computation to the columns `(i, j)` for which `active(i, j)` is true. The indices are
+         *  relative to the origin of the computation domain. The values of the outputs in the inactive columns are
+         *  unspecified, the CPU backends do not compute them.
+         */
+        template <class Interval, class Active>
+        core::masked_grid<Interval> mask_columns(core::grid<Interval> const &grid, Active const &active) {
+            return {grid, std::make_shared<core::column_mask>(grid.i_size(), grid.j_size(), active)};
+        }
+
+        /**
+         *  Restricts the computation to the listed active columns. The indices are relative to the origin of the
+         *  computation domain and must lie within it.
+         */
+        template <class Interval>
+        core::masked_grid<Interval> mask_columns(
+            core::grid<Interval> const &grid, std::vector<std::array<int_t, 2>> const &active_columns) {
+            int_t i_size = grid.i_size();
+            std::vector<bool> active(i_size * grid.j_size());
+            for (auto const &column : active_columns) {
+                if (column[0] < 0 || column[0] >= i_size || column[1] < 0 || column[1] >= grid.j_size())
+                    throw std::out_of_range("mask_columns: the active column (" + std::to_string(column[0]) + ", " +
+                                            std::to_string(column[1]) + ") is outside of the computation domain.");
+                active[column[1] * i_size + column[0]] = true;
+            }
+            return mask_columns(grid, [&](int_t i, int_t j) { return active[j * i_size + i]; });
+        }
     } // namespace stencil
 } // namespace gridtools
@@ -105,6 +105,19 @@ namespace gridtools {
                 stage_with_extent(extent<IMinus, IPlus, JMinus, JPlus>, F, Args...) const {
                     return {};
                 }
+
+                /**
+                 *  The given temporaries are not materialized: their producer stage is removed and the consumer stages
+                 *  evaluate it on the fly at every access. It should follow the stages that produce and consume the
+                 *  temporaries. The hook `inline_tmps(mss, tmps...)` is provided by the frontend of the temporaries.
+                 */
+                template <class... Tmps>
+                constexpr spec<decltype(
+                    inline_tmps(std::declval<core::mss_descriptor<ExecutionType, Esfs, Caches>>(), Tmps()...))>
+                inlined(Tmps...) const {
+                    static_assert(conjunction<core::is_tmp_arg<Tmps>...>::value, "Only temporary args can be inlined.");
+                    return {};
+                }
             };
 
             template <class ExecutionType, class... Caches>
@@ -189,15 +202,82 @@ namespace gridtools {
                 static_assert(sizeof...(Ts) < 0, "Unexpected arguments of gridtools::stencil::multi_pass.");
             }
 
+            /**
+             *  Fuses the specifications of several computations into a single multi-pass specification:
+             *
+             *    auto fused = [](auto in, auto tmp, auto out) { return fuse(diffusion(in, tmp), limiter(tmp, out)); };
+             *    run(fused, backend, grid, in, tmp, out);
+             *
+             *  The sub-specifications share the placeholders of the enclosing specification, therefore the extent
+             *  analysis sees the data dependencies between them and the blocked CPU backends execute all the stages
+             *  block by block in a single parallel region, instead of sweeping over the whole domain once per `run`.
+             *  The restrictions of a single computation apply to the fused one: a field that is read with horizontal
+             *  offsets can not be written by a later pass.
+             */
+            template <class... Msses, class... Specs>
+            constexpr meta::concat<spec<Msses...>, Specs...> fuse(spec<Msses...>, Specs...) {
+                static_assert(conjunction<meta::is_instantiation_of<spec, Specs>...>::value,
+                    "Unexpected arguments of gridtools::stencil::fuse.");
+                return {};
+            }
+
             template <size_t I>
             struct arg : std::integral_constant<size_t, I> {};
 
             template <class Interval>
             struct check_valid_apply_overloads {
                 template <class Functor>
-                using apply = core::check_valid_apply_overloads<Functor, Interval>;
+                using apply = core::check_valid_functor<Functor, Interval>;
+            };
+
+            template <class Esf>
+            using esf_args = typename Esf::args_t;
+
+            template <class Args>
+            struct is_used_in {
+                template <class Tmp>
+                using apply = meta::st_contains<Args, Tmp>;
             };
 
+            /*
+             *  The producer of an inlined temporary is removed from its pass, therefore no other pass can use the
+             *  temporary.
+             */
+            template <class Spec,
+                class Esfs = meta::flatten<meta::transform<meta::second, Spec>>,
+                class InlinedTmps = meta::dedup<
+                    meta::flatten<meta::transform<core::inlined_tmps, meta::transform<meta::first, Esfs>>>>,
+                class Args = meta::dedup<meta::flatten<meta::transform<esf_args, Esfs>>>>
+            using inlined_tmps_are_local = bool_constant<
+                meta::length<meta::filter<is_used_in<Args>::template apply, InlinedTmps>>::value == 0>;
+
+            template <class Mss>
+            using rw_args_from_mss = core::compute_readwrite_args<typename Mss::esf_sequence_t>;
+
+            template <class Msses,
+                class RwArgsLists = meta::transform<rw_args_from_mss, Msses>,
+                class RawRwArgs = meta::flatten<RwArgsLists>>
+            using all_rw_args = meta::dedup<RawRwArgs>;
+
+            /*
+             *  Optional customization point: if `gridtools_mark_modified(field)` is found by ADL, it is called after
+             *  the computation for every field that the computation writes.
+             */
+            template <class Field>
+            auto mark_modified(Field const &field, int) -> decltype(gridtools_mark_modified(field)) {
+                gridtools_mark_modified(field);
+            }
+
+            template <class Field>
+            void mark_modified(Field const &, long) {}
+
+            template <class Spec, class Arg, class Field>
+            int mark_if_written(Field const &field) {
+                if (meta::st_contains<all_rw_args<Spec>, Arg>::value)
+                    mark_modified(field, 0);
+                return 0;
+            }
+
             template <class Comp, class Backend, class Grid, class... Fields, size_t... Is>
             auto run_impl(Comp comp, Backend &&be, Grid const &grid, std::index_sequence<Is...>, Fields &&... fields)
                 -> void_t<decltype(comp(arg<Is>()...))> {
@@ -210,8 +290,11 @@ namespace gridtools {
                 static_assert(meta::all_of<check_valid_apply_overloads<typename Grid::interval_t>::template apply,
                                   functors_t>::value,
                     "Invalid stencil operator detected.");
+                static_assert(inlined_tmps_are_local<spec_t>::value,
+                    "An inlined temporary can not be used by other passes of the computation.");
 
                 using data_store_map_t = typename hymap::keys<arg<Is>...>::template values<Fields &...>;
+                using loop_t = int[sizeof...(Is)];
 #ifndef NDEBUG
                 using extent_map_t = core::get_extent_map_from_msses<spec_t>;
                 auto check_bounds = [origin = grid.origin(), size = grid.size()](auto arg, auto const &field) {
@@ -227,10 +310,10 @@ namespace gridtools {
                         });
                     return 0;
                 };
-                using loop_t = int[sizeof...(Is)];
                 (void)loop_t{check_bounds(arg<Is>(), fields)...};
 #endif
                 core::call_entry_point_f<spec_t>()(std::forward<Backend>(be), grid, data_store_map_t{fields...});
+                (void)loop_t{mark_if_written<spec_t, arg<Is>>(fields)...};
             }
 
             template <class... Ts>
@@ -263,14 +346,6 @@ namespace gridtools {
                 return {};
             }
 
-            template <class Mss>
-            using rw_args_from_mss = core::compute_readwrite_args<typename Mss::esf_sequence_t>;
-
-            template <class Msses,
-                class RwArgsLists = meta::transform<rw_args_from_mss, Msses>,
-                class RawRwArgs = meta::flatten<RwArgsLists>>
-            using all_rw_args = meta::dedup<RawRwArgs>;
-
             template <class... Msses,
                 class Arg,
                 class RwPlhs = all_rw_args<spec<Msses...>>,
@@ -282,6 +357,7 @@ namespace gridtools {
         using frontend_impl_::execute_backward;
         using frontend_impl_::execute_forward;
         using frontend_impl_::execute_parallel;
+        using frontend_impl_::fuse;
         using frontend_impl_::get_arg_extent;
         using frontend_impl_::get_arg_intent;
         using frontend_impl_::multi_pass;
@@ -0,0 +1,249 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../../common/defs.hpp"
+#include "../../common/tuple_util.hpp"
+#include "../../meta.hpp"
+#include "../../sid/concept.hpp"
+#include "../common/intent.hpp"
+#include "run.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ *  Asynchronous submission of stencil computations.
+ *
+ *  `task_graph::run` has the same signature as `stencil::run`, but instead of executing the computation immediately
+ *  it records it as a task and returns a future. The read/write sets of the task are derived from the intents of
+ *  the spec placeholders (see `get_arg_intent`). Two tasks are ordered iff they share a field and at least one of
+ *  them writes it (RAW, WAR and WAW hazards); all other tasks may run concurrently.
+ *
+ *  Fields are identified by the object a `std::shared_ptr` points to (i.e. the `data_store`) or, for other SIDs,
+ *  by their origin pointer. Fields without a pointer origin (like `global_parameter` or `positional`) are not
+ *  tracked.
+ *
+ *  Every task runs on its own host thread and calls `stencil::run` from there, so each task opens its own OpenMP
+ *  parallel region. To avoid oversubscription, at most `max_concurrent_tasks` tasks (a constructor argument, one by
+ *  default) run at the same time, and each of them runs with its share of the OpenMP threads of the thread that
+ *  created the graph. The other tasks that are ready wait for a running one to finish.
+ *
+ *  `task_graph::run` should be called from one thread only. The destructor waits for all submitted tasks.
+ *
+ *  Example:
+ *
+ *  task_graph graph(2); // two tasks at a time, with half of the threads each
+ *  graph.run(advection, backend, grid, tracer1, u, v);
+ *  graph.run(advection, backend, grid, tracer2, u, v); // independent of the first one
+ *  graph.run(diagnostics, backend, grid, tracer1, diag); // waits for the first one
+ *  graph.wait();
+ */
+
+namespace gridtools {
+    namespace stencil {
+        namespace task_graph_impl_ {
+            using field_key_t = void const *;
+
+            template <class T>
+            field_key_t field_key(std::shared_ptr<T> &obj) {
+                return obj.get();
+            }
+
+            template <class Sid, std::enable_if_t<std::is_pointer<sid::ptr_type<Sid>>::value, int> = 0>
+            field_key_t field_key(Sid &obj) {
+                return sid::get_origin(obj)();
+            }
+
+            template <class Sid, std::enable_if_t<!std::is_pointer<sid::ptr_type<Sid>>::value, int> = 0>
+            field_key_t field_key(Sid &) {
+                return nullptr;
+            }
+
+            template <class Comp, class Indices>
+            struct spec_type;
+
+            template <class Comp, size_t... Is>
+            struct spec_type<Comp, std::index_sequence<Is...>> {
+                using type = decltype(std::declval<Comp &>()(frontend_impl_::arg<Is>()...));
+            };
+
+            template <class Spec, size_t... Is>
+            std::array<bool, sizeof...(Is)> written_args(std::index_sequence<Is...>) {
+                return {(decltype(get_arg_intent(Spec(), frontend_impl_::arg<Is>()))::value == intent::inout)...};
+            }
+
+            /*
+             *  A counting semaphore for the tasks that are allowed to run at the same time.
+             */
+            class task_slots {
+                std::mutex m_mutex;
+                std::condition_variable m_cv;
+                int m_free;
+
+              public:
+                task_slots(int count) : m_free(count) {}
+
+                void acquire() {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_cv.wait(lock, [&] { return m_free > 0; });
+                    --m_free;
+                }
+
+                void release() {
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        ++m_free;
+                    }
+                    m_cv.notify_one();
+                }
+            };
+
+            inline int max_threads() {
+#ifdef _OPENMP
+                return omp_get_max_threads();
+#else
+                return 1;
+#endif
+            }
+
+            class task_graph {
+                using future_t = std::shared_future<void>;
+
+                struct field_state {
+                    future_t last_writer;
+                    std::vector<future_t> readers;
+                };
+
+                std::map<field_key_t, field_state> m_fields;
+                std::vector<future_t> m_tasks;
+                task_slots m_slots;
+                int m_threads_per_task;
+
+                template <size_t N>
+                std::vector<future_t> dependencies(
+                    std::array<field_key_t, N> const &keys, std::array<bool, N> const &written) {
+                    std::vector<future_t> res;
+                    for (size_t i = 0; i != N; ++i) {
+                        if (!keys[i])
+                            continue;
+                        auto const &state = m_fields[keys[i]];
+                        if (state.last_writer.valid())
+                            res.push_back(state.last_writer);
+                        if (written[i])
+                            res.insert(res.end(), state.readers.begin(), state.readers.end());
+                    }
+                    return res;
+                }
+
+                template <size_t N>
+                void register_accesses(
+                    std::array<field_key_t, N> const &keys, std::array<bool, N> const &written, future_t const &task) {
+                    for (size_t i = 0; i != N; ++i) {
+                        if (!keys[i])
+                            continue;
+                        auto &state = m_fields[keys[i]];
+                        if (written[i]) {
+                            state.last_writer = task;
+                            state.readers.clear();
+                        } else {
+                            state.readers.push_back(task);
+                        }
+                    }
+                }
+
+              public:
+                /**
+                 *  At most `max_concurrent_tasks` tasks run at the same time, each with an equal share of the OpenMP
+                 *  threads of the calling thread.
+                 */
+                explicit task_graph(int max_concurrent_tasks = 1)
+                    : m_slots(std::max(max_concurrent_tasks, 1)),
+                      m_threads_per_task(std::max(max_threads() / std::max(max_concurrent_tasks, 1), 1)) {}
+
+                task_graph(task_graph const &) = delete;
+                task_graph &operator=(task_graph const &) = delete;
+                ~task_graph() {
+                    for (auto &&task : m_tasks)
+                        task.wait();
+                }
+
+                /**
+                 *  Submits `stencil::run(comp, be, grid, fields...)` for the asynchronous execution.
+                 *  The fields are stored by value until the task is finished.
+                 */
+                template <class Comp, class Backend, class Grid, class... Fields>
+                future_t run(Comp comp, Backend be, Grid const &grid, Fields &&... fields) {
+                    using indices_t = std::index_sequence_for<Fields...>;
+                    using spec_t = typename spec_type<Comp, indices_t>::type;
+                    static_assert(meta::is_instantiation_of<frontend_impl_::spec, spec_t>::value,
+                        "Invalid stencil composition specification.");
+                    auto args = std::make_tuple(std::decay_t<Fields>(std::forward<Fields>(fields))...);
+                    auto keys = tuple_util::convert_to<std::array, field_key_t>(
+                        tuple_util::transform([](auto &field) { return field_key(field); }, args));
+                    auto written = written_args<spec_t>(indices_t());
+                    auto deps = dependencies(keys, written);
+                    future_t task = std::async(std::launch::async,
+                        [comp,
+                            be = std::move(be),
+                            grid,
+                            args = std::move(args),
+                            deps = std::move(deps),
+                            slots = &m_slots,
+                            threads = m_threads_per_task]() mutable {
+                            for (auto &&dep : deps)
+                                dep.get();
+#ifdef _OPENMP
+                            omp_set_num_threads(threads);
+#else
+                            (void)threads;
+#endif
+                            slots->acquire();
+                            struct release_f {
+                                task_slots *slots;
+                                ~release_f() { slots->release(); }
+                            } release = {slots};
+                            tuple_util::apply(
+                                [&](auto &... fields) { ::gridtools::stencil::run(comp, be, grid, fields...); }, args);
+                        });
+                    register_accesses(keys, written, task);
+                    m_tasks.push_back(task);
+                    return task;
+                }
+
+                /**
+                 *  Blocks until all submitted tasks are finished. Rethrows the first exception thrown by a task.
+                 */
+                void wait() {
+                    auto tasks = std::move(m_tasks);
+                    m_tasks.clear();
+                    m_fields.clear();
+                    for (auto &&task : tasks)
+                        task.get();
+                }
+            };
+        } // namespace task_graph_impl_
+        using task_graph_impl_::task_graph;
+    } // namespace stencil
+} // namespace gridtools
@@ -9,9 +9,16 @@
  */
 #pragma once
 
+#include <array>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 
+#include "../common/array.hpp"
 #include "../common/defs.hpp"
 #include "../common/generic_metafunctions/accumulate.hpp"
 #include "../common/generic_metafunctions/for_each.hpp"
@@ -29,6 +36,7 @@ namespace gridtools {
         namespace builder_impl_ {
             namespace param {
                 struct type {};
+                struct compute_type {};
                 struct lengths {};
                 struct id {};
                 struct name {};
@@ -47,22 +55,43 @@ namespace gridtools {
                 return obj;
             }
 
-            template <class Fun, class T, class Layout, class Info, size_t... Is>
-            void initializer_impl(Fun const &fun, T *dst, Layout layout, Info const &info, std::index_sequence<Is...>) {
-                int length = info.length();
-                auto in_range = [&](auto const &indices) {
-                    for (auto ok : {(tuple_util::get<Is>(indices) < tuple_util::get<Is>(info.native_lengths()))...})
-                        if (!ok)
-                            return false;
-                    return true;
-                };
+            /*
+             *  The elements are visited by a loop nest in the stride order given by the layout: the outer (row)
+             *  dimensions are flattened and distributed among the threads, the innermost dimension has unit stride
+             *  and its loop is vectorizable. Padding is not visited. Masked dimensions get the last index.
+             */
+            template <class Fun, class T, int... Ls, class Info, size_t... Is>
+            void initializer_impl(
+                Fun const &fun, T *dst, layout_map<Ls...>, Info const &info, std::index_sequence<Is...>) {
+                using layout_t = layout_map<Ls...>;
+                static constexpr int inner = layout_t::max_arg < 0 ? -1 : (int)layout_t::find(layout_t::max_arg);
+                if (info.length() == 0)
+                    return;
+                auto lengths = tuple_util::convert_to<array, int>(info.native_lengths());
+                int inner_length = inner < 0 ? 1 : lengths[inner];
+                // row dimensions sorted by increasing stride
+                array<int, sizeof...(Is) + 1> row_dims;
+                int num_row_dims = 0;
+                int num_rows = 1;
+                for (int pos = layout_t::max_arg - 1; pos >= 0; --pos) {
+                    int dim = layout_t::find(pos);
+                    row_dims[num_row_dims++] = dim;
+                    num_rows *= lengths[dim];
+                }
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-                for (int i = 0; i < length; ++i) {
-                    auto indices = info.indices(layout, i);
-                    if (in_range(indices))
-                        dst[i] = fun(tuple_util::get<Is>(indices)...);
+                for (int row = 0; row < num_rows; ++row) {
+                    array<int, sizeof...(Is)> indices = {(Ls == -1 ? lengths[Is] - 1 : 0)...};
+                    for (int n = 0, r = row; n < num_row_dims; ++n) {
+                        int dim = row_dims[n];
+                        indices[dim] = r % lengths[dim];
+                        r /= lengths[dim];
+                    }
+                    T *ptr = dst + info.index(indices[Is]...);
+#pragma omp simd
+                    for (int i = 0; i < inner_length; ++i)
+                        ptr[i] = static_cast<T>(fun(((int)Is == inner ? i : indices[Is])...));
                 }
             }
 
@@ -78,11 +107,12 @@ namespace gridtools {
             auto wrap_value(T const &value) {
                 return [value = std::move(value)](auto *dst, auto, auto const &info) {
                     int length = info.length();
+                    auto stored = static_cast<std::remove_pointer_t<decltype(dst)>>(value);
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
                     for (int i = 0; i < length; ++i)
-                        dst[i] = value;
+                        dst[i] = stored;
                 };
             }
 
@@ -93,6 +123,96 @@ namespace gridtools {
                 }
             };
 
+            /*
+             *  The arena of the data stores that are built by `build_group` or `build_interleaved`. It is allocated
+             *  by the first member and the members start `step` elements apart.
+             */
+            struct group_arena {
+                size_t members = 0;
+                size_t step = 0;
+                size_t size = 0;
+                std::shared_ptr<void> block;
+                char *next = nullptr;
+            };
+
+            inline group_arena &current_group_arena() {
+                static thread_local group_arena res;
+                return res;
+            }
+
+            /*
+             *  The most recent arena of the data stores of the given kind. Composites shift the members of an arena
+             *  through a single base pointer, thus at most one arena of a kind may be alive at a time.
+             */
+            struct arena_registry {
+                std::mutex mutex;
+                std::weak_ptr<void> block;
+            };
+
+            template <class Kind>
+            arena_registry &live_arena() {
+                static arena_registry res;
+                return res;
+            }
+
+            template <class Traits, class T>
+            std::shared_ptr<T> allocate_from_arena(size_t size, size_t step) {
+                auto &arena = current_group_arena();
+                assert(arena.members > 0);
+                if (!arena.block) {
+                    auto holder = std::make_shared<traits::target_ptr_type<Traits, T>>(
+                        traits::allocate<Traits, T>((arena.members - 1) * step + size));
+                    arena.size = size;
+                    arena.next = reinterpret_cast<char *>(holder->get());
+                    arena.block = {holder, arena.next};
+                }
+                assert(arena.size == size);
+                std::shared_ptr<T> res = {arena.block, reinterpret_cast<T *>(arena.next)};
+                arena.next += step * sizeof(T);
+                return res;
+            }
+
+            template <class Traits, class Tag>
+            struct group_traits : Traits {
+                friend meta::lazy::id<meta::list<Tag>> storage_arena(group_traits) { return {}; }
+
+                template <class LazyType, class T = typename LazyType::type>
+                friend std::shared_ptr<T> storage_allocate(group_traits, LazyType, size_t size) {
+                    // the members start at the same misalignment, so their origins are equidistant
+                    constexpr size_t alignment = traits::alignment<Traits>;
+                    constexpr size_t step = alignment > sizeof(T) ? alignment / sizeof(T) : 1;
+                    size = (size + step - 1) / step * step;
+                    return allocate_from_arena<Traits, T>(size, size);
+                }
+            };
+
+            /*
+             *  The strides of the members leave room for the rows of `N` fields, the members start one padded row
+             *  apart.
+             */
+            template <class Traits, int N, class Tag>
+            struct interleaved_traits : Traits {
+                friend std::integral_constant<int, N> storage_interleave(interleaved_traits) { return {}; }
+                friend meta::lazy::id<meta::list<Tag>> storage_arena(interleaved_traits) { return {}; }
+
+                template <class LazyType, class T = typename LazyType::type>
+                friend std::shared_ptr<T> storage_allocate(interleaved_traits, LazyType, size_t size) {
+                    return allocate_from_arena<Traits, T>(size, current_group_arena().step);
+                }
+            };
+
+            template <class Tag>
+            struct group {
+                template <class Traits>
+                using apply = group_traits<Traits, Tag>;
+            };
+
+            template <int N, class Tag>
+            struct interleave {
+                template <class Traits>
+                using apply = interleaved_traits<Traits, N, Tag>;
+            };
+
             template <class... Keys>
             struct keys {
                 template <class... Vals>
@@ -218,6 +338,16 @@ namespace gridtools {
                     return add_type<param::type, meta::lazy::id<T>>();
                 }
 
+                /**
+                 *  Mixed precision: the data is stored as `type`, but stencils and host views access it as `T`.
+                 *  The halo exchange and the target views operate on the stored (compact) representation.
+                 */
+                template <class T>
+                auto compute_type() const {
+                    static_assert(!has<param::compute_type>::value, "storage compute type is set twice");
+                    return add_type<param::compute_type, meta::lazy::id<T>>();
+                }
+
                 template <int I>
                 auto id() const {
                     static_assert(!has<param::id>::value, "storage id is set twice");
@@ -275,20 +405,99 @@ namespace gridtools {
                     return add_value<param::initializer>(wrap_value(std::move(value)));
                 }
 
-                auto build() const {
+              private:
+                template <template <class> class Wrap = meta::id>
+                auto make() const {
                     static_assert(has<param::type>::value, "storage type is not set");
                     static_assert(has<param::lengths>::value, "storage lengths are not set");
-                    using traits_t =
+                    using layout_traits_t =
                         meta::if_c<has<param::layout>::value, custom_traits<Traits, value_type<param::layout>>, Traits>;
+                    using traits_t = Wrap<layout_traits_t>;
                     auto &&lengths = value<param::lengths>();
                     auto &&name = value<param::name, std::string>();
                     constexpr auto n = tuple_util::size<decltype(lengths)>::value;
                     auto &&halos = value<param::halos, array<int, n>>();
                     auto initializer = value<param::initializer, uninitialized>();
-                    return make_data_store<traits_t, typename value_type<param::type>::type, value_type<param::id>>(
+                    using data_t = typename value_type<param::type>::type;
+                    using compute_t = typename meta::if_c<has<param::compute_type>::value,
+                        value_type<param::compute_type>,
+                        meta::lazy::id<std::remove_const_t<data_t>>>::type;
+                    return make_data_store<traits_t, data_t, value_type<param::id>, compute_t>(
                         name, lengths, halos, initializer);
                 }
 
+                template <template <class> class Wrap, class Fill>
+                auto build_in_arena(size_t members, size_t step, Fill &&fill) const {
+                    using kind_t = typename decltype(make<Wrap>())::element_type::kind_t;
+                    auto &live = live_arena<kind_t>();
+                    std::lock_guard<std::mutex> lock(live.mutex);
+                    if (!live.block.expired())
+                        throw std::runtime_error("the data stores of another group with the same properties and tag "
+                                                 "are alive, use a different tag");
+                    struct guard {
+                        guard(size_t members, size_t step) {
+                            auto &arena = current_group_arena();
+                            arena = {};
+                            arena.members = members;
+                            arena.step = step;
+                        }
+                        ~guard() { current_group_arena() = {}; }
+                    } arena(members, step);
+                    auto res = fill();
+                    live.block = current_group_arena().block;
+                    return res;
+                }
+
+              public:
+                auto build() const { return make(); }
+
+                /**
+                 *  Builds `n` data stores that share one allocation. The members are laid out back to back, thus the
+                 *  distance between their origins is fixed for their lifetime; the allocation is freed together with
+                 *  the last member. The members have a strides kind of their own (`sid::arena_kind`), so that
+                 *  composites of them are shifted through a single base pointer. For the same reason only one group
+                 *  with the same properties and `Tag` may be alive at a time, otherwise `std::runtime_error` is thrown.
+                 */
+                template <class Tag = void>
+                auto build_group(size_t n) const {
+                    return build_in_arena<group<Tag>::template apply>(n, 0, [&] {
+                        std::vector<decltype(make<group<Tag>::template apply>())> res;
+                        res.reserve(n);
+                        for (size_t i = 0; i != n; ++i)
+                            res.push_back(make<group<Tag>::template apply>());
+                        return res;
+                    });
+                }
+
+                /**
+                 *  Builds `N` data stores whose whole padded rows along the stride-1 dimension are interleaved in one
+                 *  allocation: the row of the n-th member follows the row of the (n-1)-th member with the same
+                 *  indices. The elements within a row are not interleaved: each member is an ordinary data store with
+                 *  its own stride pattern, its strides skip the rows of the others. The members are initialized by the
+                 *  same initializer and are available for host referenceable storages only. As for `build_group`,
+                 *  only one such set with the same properties and `Tag` may be alive at a time.
+                 */
+                template <int N, class Tag = void>
+                auto build_interleaved() const {
+                    static_assert(N > 0, "the number of interleaved data stores should be positive");
+                    static_assert(traits::is_host_referenceable<Traits>,
+                        "interleaved data stores are not supported by the storage traits");
+                    using data_t = std::remove_const_t<typename value_type<param::type>::type>;
+                    auto &&lengths = value<param::lengths>();
+                    using layout_t = typename decltype(make())::element_type::layout_t;
+                    static_assert(layout_t::unmasked_length > 1, "at least two dimensions are needed for interleaving");
+                    auto alignment = data_store_impl_::get_alignment<Traits, data_t>();
+                    auto strides = make_info<layout_t>(alignment, lengths).native_strides();
+                    return build_in_arena<interleave<N, Tag>::template apply>(N,
+                        tuple_util::get<layout_t::find(layout_t::max_arg - 1)>(strides),
+                        [&] {
+                            std::array<decltype(make<interleave<N, Tag>::template apply>()), N> res;
+                            for (auto &&member : res)
+                                member = make<interleave<N, Tag>::template apply>();
+                            return res;
+                        });
+                }
+
                 auto operator()() const { return build(); }
             };
             template <class Traits>
@@ -18,6 +18,7 @@
 #include "../common/defs.hpp"
 #include "../common/integral_constant.hpp"
 #include "../common/layout_map.hpp"
+#include "../sid/arena_kind.hpp"
 #include "data_view.hpp"
 #include "info.hpp"
 #include "traits.hpp"
@@ -38,7 +39,7 @@ namespace gridtools {
             template <class Traits, class T, size_t ByteAlignment = traits::alignment<Traits>>
             using get_alignment = integral_constant<int, ByteAlignment / gcd(sizeof(T), ByteAlignment)>;
 
-            template <class Traits, class T, class Info, class Id>
+            template <class Traits, class T, class Info, class Id, class Compute>
             class base {
                 static constexpr size_t byte_alignment = traits::alignment<Traits>;
                 static_assert(byte_alignment > 0, GT_INTERNAL_ERROR);
@@ -52,15 +53,25 @@ namespace gridtools {
                 Info m_info;
                 traits::target_ptr_type<Traits, mutable_data_t> m_target_ptr_holder;
                 mutable_data_t *m_target_ptr;
+                mutable size_t m_version = 0;
 
               public:
                 using layout_t = traits::layout_type<Traits, Info::ndims>;
                 using data_t = T;
+                // the type the stencils compute with; differs from `data_t` for mixed precision fields
+                using compute_t = Compute;
                 static constexpr size_t ndims = Info::ndims;
 
+                using own_kind_t = meta::if_c<(traits::interleave<Traits> > 1),
+                    meta::list<layout_t, Id, alignment_t, std::integral_constant<int, traits::interleave<Traits>>>,
+                    meta::list<layout_t, Id, meta::if_c<(layout_t::unmasked_length > 1), alignment_t, void>>>;
+
+                // the members of an arena get a kind of their own, so that composites can shift them together
                 using kind_t = meta::if_<tuple_util::is_empty_or_tuple_of_empties<strides_t>,
                     strides_t,
-                    meta::list<layout_t, Id, meta::if_c<(layout_t::unmasked_length > 1), alignment_t, void>>>;
+                    meta::if_<std::is_void<traits::arena<Traits>>,
+                        own_kind_t,
+                        sid::arena_kind<meta::push_back<own_kind_t, traits::arena<Traits>>>>>;
 
                 auto const &name() const { return m_name; }
                 auto const &info() const { return m_info; }
@@ -70,6 +81,16 @@ namespace gridtools {
                 decltype(auto) strides() const { return m_info.strides(); }
                 decltype(auto) length() const { return m_info.length(); }
 
+                /**
+                 *  Modification counter.
+                 *
+                 *  It is incremented every time a mutable pointer or view is handed out (`get_target_ptr`,
+                 *  `get_host_ptr`, `target_view`, `host_view`) and by `stencil::run` for the fields that the
+                 *  computation writes. Accessing the data store through the SID interface doesn't change it.
+                 */
+                size_t version() const { return m_version; }
+                void increment_version() const { ++m_version; }
+
               protected:
                 template <class Halos>
                 base(std::string name, Info info, Halos const &halos)
@@ -89,12 +110,13 @@ namespace gridtools {
                 class T,
                 class Info,
                 class Id,
+                class Compute = std::remove_const_t<T>,
                 bool = std::is_const<T>::value,
                 bool = traits::is_host_referenceable<Traits>>
             class data_store;
 
-            template <class Traits, class T, class Info, class Id>
-            class data_store<Traits, T, Info, Id, false, false> : public base<Traits, T, Info, Id> {
+            template <class Traits, class T, class Info, class Id, class Compute>
+            class data_store<Traits, T, Info, Id, Compute, false, false> : public base<Traits, T, Info, Id, Compute> {
                 enum state { synced, invalid_host, invalid_target };
                 state m_state;
                 std::unique_ptr<T[]> m_host_ptr;
@@ -127,6 +149,12 @@ namespace gridtools {
                 }
 
                 T *get_target_ptr() {
+                    this->increment_version();
+                    return get_untracked_target_ptr();
+                }
+
+                // The same as `get_target_ptr`, but doesn't count as a modification.
+                T *get_untracked_target_ptr() {
                     update_target();
                     m_state = invalid_host;
                     return this->raw_target_ptr();
@@ -140,6 +168,7 @@ namespace gridtools {
                 T *get_host_ptr() {
                     update_host();
                     m_state = invalid_target;
+                    this->increment_version();
                     return m_host_ptr.get();
                 }
 
@@ -148,8 +177,8 @@ namespace gridtools {
                     return m_host_ptr.get();
                 }
 
-                auto host_view() { return make_host_view(get_host_ptr(), this->info()); }
-                auto const_host_view() { return make_host_view(get_const_host_ptr(), this->info()); }
+                auto host_view() { return make_host_view<Compute>(get_host_ptr(), this->info()); }
+                auto const_host_view() { return make_host_view<Compute>(get_const_host_ptr(), this->info()); }
 
                 auto target_view() { return traits::make_target_view<Traits>(get_target_ptr(), this->info()); }
                 auto const_target_view() {
@@ -157,8 +186,8 @@ namespace gridtools {
                 }
             };
 
-            template <class Traits, class T, class Info, class Id>
-            class data_store<Traits, T, Info, Id, false, true> : public base<Traits, T, Info, Id> {
+            template <class Traits, class T, class Info, class Id, class Compute>
+            class data_store<Traits, T, Info, Id, Compute, false, true> : public base<Traits, T, Info, Id, Compute> {
               public:
                 template <class Halos>
                 data_store(std::string name, Info info, Halos const &halos, uninitialized const &)
@@ -170,7 +199,12 @@ namespace gridtools {
                     initializer(this->raw_target_ptr(), typename data_store::layout_t(), this->info());
                 }
 
-                T *get_target_ptr() const { return this->raw_target_ptr(); }
+                T *get_target_ptr() const {
+                    this->increment_version();
+                    return this->raw_target_ptr();
+                }
+                // The same as `get_target_ptr`, but doesn't count as a modification.
+                T *get_untracked_target_ptr() const { return this->raw_target_ptr(); }
                 T const *get_const_target_ptr() const { return this->raw_target_ptr(); }
 
                 auto target_view() const { return traits::make_target_view<Traits>(get_target_ptr(), this->info()); }
@@ -180,13 +214,13 @@ namespace gridtools {
 
                 T *get_host_ptr() { return get_target_ptr(); }
                 T const *get_const_host_ptr() { return get_const_target_ptr(); }
-                auto host_view() const { return target_view(); }
-                auto const_host_view() const { return const_target_view(); }
+                auto host_view() const { return make_host_view<Compute>(get_target_ptr(), this->info()); }
+                auto const_host_view() const { return make_host_view<Compute>(get_const_target_ptr(), this->info()); }
             };
 
-            template <class Traits, class T, class Info, class Id, bool IsHostRefrenceable>
-            class data_store<Traits, T const, Info, Id, true, IsHostRefrenceable>
-                : public base<Traits, T const, Info, Id> {
+            template <class Traits, class T, class Info, class Id, class Compute, bool IsHostRefrenceable>
+            class data_store<Traits, T const, Info, Id, Compute, true, IsHostRefrenceable>
+                : public base<Traits, T const, Info, Id, Compute> {
 
                 template <class>
                 struct is_host_refrenceable : bool_constant<IsHostRefrenceable> {};
@@ -209,10 +243,11 @@ namespace gridtools {
 
                 template <class Initializer, class Halos>
                 data_store(std::string name, Info info, Halos const &halos, Initializer const &initializer)
-                    : base<Traits, T const, Info, Id>(std::move(name), std::move(info), halos) {
+                    : base<Traits, T const, Info, Id, Compute>(std::move(name), std::move(info), halos) {
                     init(initializer);
                 }
                 T const *get_target_ptr() const { return this->raw_target_ptr(); }
+                T const *get_untracked_target_ptr() const { return this->raw_target_ptr(); }
                 auto target_view() const { return traits::make_target_view<Traits>(get_target_ptr(), this->info()); }
                 auto get_const_target_ptr() const { return get_target_ptr(); }
                 auto const_target_view() const { return target_view(); }
@@ -221,28 +256,34 @@ namespace gridtools {
             template <class>
             struct is_data_store : std::false_type {};
 
-            template <class Traits, class T, class Info, class Id>
-            struct is_data_store<data_store<Traits, T, Info, Id>> : std::true_type {};
+            template <class Traits, class T, class Info, class Id, class Compute>
+            struct is_data_store<data_store<Traits, T, Info, Id, Compute>> : std::true_type {};
 
             template <class>
             struct is_data_store_ptr : std::false_type {};
 
-            template <class Traits, class T, class Info, class Id>
-            struct is_data_store_ptr<std::shared_ptr<data_store<Traits, T, Info, Id>>> : std::true_type {};
+            template <class Traits, class T, class Info, class Id, class Compute>
+            struct is_data_store_ptr<std::shared_ptr<data_store<Traits, T, Info, Id, Compute>>> : std::true_type {};
 
-            template <class Traits, class T, class Id, class Info, class Halos, class Initializer>
+            template <class Traits, class T, class Id, class Compute, class Info, class Halos, class Initializer>
             auto make_data_store_helper(
                 std::string name, Info info, Halos const &halos, Initializer const &initializer) {
-                return std::make_shared<data_store<Traits, T, Info, Id>>(
+                return std::make_shared<data_store<Traits, T, Info, Id, Compute>>(
                     std::move(name), std::move(info), halos, initializer);
             }
 
-            template <class Traits, class T, class Id, class Lengths, class Halos, class Initializer>
+            template <class Traits,
+                class T,
+                class Id,
+                class Compute = std::remove_const_t<T>,
+                class Lengths,
+                class Halos,
+                class Initializer>
             auto make_data_store(
                 std::string name, Lengths const &lengths, Halos const &halos, Initializer const &initializer) {
-                return make_data_store_helper<Traits, T, Id>(std::move(name),
+                return make_data_store_helper<Traits, T, Id, Compute>(std::move(name),
                     make_info<traits::layout_type<Traits, tuple_util::size<Lengths>::value>>(
-                        get_alignment<Traits, T>(), lengths),
+                        get_alignment<Traits, T>(), lengths, integral_constant<int, traits::interleave<Traits>>()),
                     halos,
                     initializer);
             }
@@ -9,13 +9,19 @@
  */
 #pragma once
 
+#include <type_traits>
 #include <utility>
 
 #include "../common/array.hpp"
+#include "../common/converting_ptr.hpp"
 
 namespace gridtools {
     namespace storage {
-        template <class T, class Info>
+        /**
+         *  `T` is the stored type, `Compute` is the type the elements are accessed as. If they differ, `operator()`
+         *  returns a `converting_ref` while `data()` still gives the raw (compact) data.
+         */
+        template <class T, class Info, class Compute = std::remove_const_t<T>>
         struct host_view {
             T *m_ptr;
             Info const *m_info;
@@ -30,17 +36,23 @@ namespace gridtools {
             decltype(auto) native_strides() const { return m_info->native_strides(); }
 
             template <class... Args>
-            auto operator()(Args &&... args) const -> decltype(m_ptr[m_info->index(std::forward<Args>(args)...)]) {
-                return m_ptr[m_info->index(std::forward<Args>(args)...)];
+            auto operator()(Args &&... args) const
+                -> decltype(*make_converting_ptr<Compute>(m_ptr + m_info->index(std::forward<Args>(args)...))) {
+                return *make_converting_ptr<Compute>(m_ptr + m_info->index(std::forward<Args>(args)...));
             }
 
             decltype(auto) operator()(array<int, Info::ndims> const &arg) const {
-                return m_ptr[m_info->index_from_tuple(arg)];
+                return *make_converting_ptr<Compute>(m_ptr + m_info->index_from_tuple(arg));
             }
         };
 
-        template <class T, class Info>
-        host_view<T, Info> make_host_view(T *ptr, Info const &info) {
+        template <class Compute = void,
+            class T,
+            class Info,
+            class Res = host_view<T,
+                Info,
+                std::conditional_t<std::is_void<Compute>::value, std::remove_const_t<T>, Compute>>>
+        Res make_host_view(T *ptr, Info const &info) {
             return {ptr, &info};
         }
     } // namespace storage
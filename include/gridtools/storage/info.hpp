@@ -35,16 +35,21 @@ namespace gridtools {
                 using type = tuple<integral_constant<int, Is>...>;
             };
 
-            template <class Layout, class Align>
+            /*
+             *  The stride-1 dimension is padded to a multiple of the alignment. With `Interleave > 1` the padded rows
+             *  of `Interleave` fields alternate in memory, thus the row is reserved `Interleave` times.
+             */
+            template <class Layout, class Align, class Interleave>
             struct make_padded_length_f {
                 Align m_align;
+                Interleave m_interleave;
                 template <class Length>
                 integral_constant<int, 1> operator()(integral_constant<int, -1>, Length) const {
                     return {};
                 }
                 template <int Max = Layout::max_arg, class Length, std::enable_if_t<Max != 0 && Max != -1, int> = 0>
                 auto operator()(integral_constant<int, Layout::max_arg>, Length length) const {
-                    return (length + m_align - integral_constant<int, 1>()) / m_align * m_align;
+                    return (length + m_align - integral_constant<int, 1>()) / m_align * m_align * m_interleave;
                 }
                 template <int I, class Length>
                 auto operator()(integral_constant<int, I>, Length length) const {
@@ -52,10 +57,11 @@ namespace gridtools {
                 }
             };
 
-            template <class Layout, class Align, class Lengths>
-            auto make_padded_lengths(Align align, Lengths const &lengths) {
-                return tuple_util::transform(
-                    make_padded_length_f<Layout, Align>{align}, typename layout_tuple<Layout>::type(), lengths);
+            template <class Layout, class Align, class Interleave, class Lengths>
+            auto make_padded_lengths(Align align, Interleave interleave, Lengths const &lengths) {
+                return tuple_util::transform(make_padded_length_f<Layout, Align, Interleave>{align, interleave},
+                    typename layout_tuple<Layout>::type(),
+                    lengths);
             }
 
             template <class Layout, class Lengths>
@@ -79,9 +85,9 @@ namespace gridtools {
                     make_stride_f<Layout, Lengths>{lengths}, typename layout_tuple<Layout>::type());
             }
 
-            template <class Layout, class Align, class Lengths>
-            auto make_strides(Align align, Lengths const &lengths) {
-                return make_strides_helper<Layout>(make_padded_lengths<Layout>(align, lengths));
+            template <class Layout, class Align, class Interleave, class Lengths>
+            auto make_strides(Align align, Interleave interleave, Lengths const &lengths) {
+                return make_strides_helper<Layout>(make_padded_lengths<Layout>(align, interleave, lengths));
             }
 
             template <class Lengths, class Strides, class = std::make_index_sequence<tuple_util::size<Lengths>::value>>
@@ -144,9 +150,9 @@ namespace gridtools {
                 return {std::move(lengths), std::move(strides)};
             }
 
-            template <class Layout, class Align, class Lengths>
-            auto make_info(Align align, Lengths const &lengths) {
-                return make_info_helper(lengths, make_strides<Layout>(align, lengths));
+            template <class Layout, class Align, class Lengths, class Interleave = integral_constant<int, 1>>
+            auto make_info(Align align, Lengths const &lengths, Interleave interleave = {}) {
+                return make_info_helper(lengths, make_strides<Layout>(align, interleave, lengths));
             }
         } // namespace info_impl_
         using info_impl_::make_info;
@@ -12,6 +12,7 @@
 
 #include <cassert>
 
+#include "../common/converting_ptr.hpp"
 #include "../common/defs.hpp"
 #include "../common/host_device.hpp"
 #include "../common/hymap.hpp"
@@ -30,12 +31,19 @@ namespace gridtools {
                 friend GT_CONSTEXPR GT_FUNCTION T *operator+(T *lhs, empty_ptr_diff) {
                     return lhs;
                 }
+                template <class Compute, class T>
+                friend GT_CONSTEXPR GT_FUNCTION converting_ptr<Compute, T> operator+(
+                    converting_ptr<Compute, T> lhs, empty_ptr_diff) {
+                    return lhs;
+                }
             };
 
-            template <class T>
+            template <class T, class Compute = std::remove_const_t<T>>
             struct ptr_holder {
                 T *m_val;
-                GT_FUNCTION GT_CONSTEXPR T *operator()() const { return m_val; }
+                GT_FUNCTION GT_CONSTEXPR converting_ptr_type<Compute, T> operator()() const {
+                    return make_converting_ptr<Compute>(m_val);
+                }
 
                 friend GT_FORCE_INLINE constexpr ptr_holder operator+(ptr_holder obj, int_t arg) {
                     return {obj.m_val + arg};
@@ -71,8 +79,9 @@ namespace gridtools {
          *   The functions below make `data_store` model the `SID` concept
          */
         template <class DataStore, std::enable_if_t<is_data_store<DataStore>::value, int> = 0>
-        storage_sid_impl_::ptr_holder<typename DataStore::data_t> sid_get_origin(std::shared_ptr<DataStore> const &ds) {
-            return {ds->get_target_ptr()};
+        storage_sid_impl_::ptr_holder<typename DataStore::data_t, typename DataStore::compute_t> sid_get_origin(
+            std::shared_ptr<DataStore> const &ds) {
+            return {ds->get_untracked_target_ptr()};
         }
 
         template <class DataStore, std::enable_if_t<is_data_store<DataStore>::value, int> = 0>
@@ -99,5 +108,13 @@ namespace gridtools {
             using layout_t = typename DataStore::layout_t;
             return storage_sid_impl_::filter_unmasked_bounds(layout_t(), ds->native_lengths());
         }
+
+        /**
+         *   `stencil::run` calls this for every data store that the computation writes
+         */
+        template <class DataStore, std::enable_if_t<is_data_store<DataStore>::value, int> = 0>
+        void gridtools_mark_modified(std::shared_ptr<DataStore> const &ds) {
+            ds->increment_version();
+        }
     } // namespace storage
 } // namespace gridtools
@@ -30,6 +30,24 @@ namespace gridtools {
             using layout_type =
                 decltype(storage_layout(std::declval<Traits>(), std::integral_constant<size_t, Dims>()));
 
+            // the number of fields that are interleaved row by row, one unless the traits tell otherwise
+            template <class Traits>
+            std::integral_constant<int, 1> storage_interleave(Traits) {
+                return {};
+            }
+
+            template <class Traits>
+            constexpr int interleave = decltype(storage_interleave(std::declval<Traits>()))::value;
+
+            // the tag of the arena that the data stores share, `void` if each has an allocation of its own
+            template <class Traits>
+            meta::lazy::id<void> storage_arena(Traits) {
+                return {};
+            }
+
+            template <class Traits>
+            using arena = typename decltype(storage_arena(std::declval<Traits>()))::type;
+
             template <class Traits, class T>
             auto allocate(size_t size) {
                 return storage_allocate(Traits(), meta::lazy::id<T>(), size);
@@ -0,0 +1,193 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+/*
+ *  Minimal, hwloc-free CPU topology queries and thread pinning.
+ *
+ *  The topology is read from the Linux sysfs (`/sys/devices/system/cpu` and `/sys/devices/system/node`).
+ *  All functions return logical CPU ids as used by `sched_setaffinity`.
+ */
+namespace gridtools {
+    namespace thread_pool {
+        namespace affinity {
+            /**
+             *  Parses the kernel cpu list format, like "0-3,8,10-11".
+             */
+            inline std::vector<int> parse_cpu_list(std::string const &src) {
+                std::vector<int> res;
+                std::istringstream strm(src);
+                std::string item;
+                while (std::getline(strm, item, ',')) {
+                    item.erase(std::remove_if(item.begin(), item.end(), [](char c) { return std::isspace(c); }),
+                        item.end());
+                    if (item.empty())
+                        continue;
+                    auto dash = item.find('-');
+                    try {
+                        int first = std::stoi(item.substr(0, dash));
+                        int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+                        if (first < 0 || last < first)
+                            throw std::invalid_argument(item);
+                        for (int cpu = first; cpu <= last; ++cpu)
+                            res.push_back(cpu);
+                    } catch (std::logic_error const &) {
+                        throw std::runtime_error("invalid cpu list: \"" + src + "\"");
+                    }
+                }
+                std::sort(res.begin(), res.end());
+                res.erase(std::unique(res.begin(), res.end()), res.end());
+                return res;
+            }
+
+            /**
+             *  Reads a cpu list from a sysfs file. Returns an empty list if the file does not exist.
+             */
+            inline std::vector<int> read_cpu_list(std::string const &path) {
+                std::ifstream file(path);
+                std::string line;
+                if (!file || !std::getline(file, line))
+                    return {};
+                return parse_cpu_list(line);
+            }
+
+            inline std::string sysfs_cpu_root() { return "/sys/devices/system/cpu/"; }
+
+            inline std::string sysfs_node_root() { return "/sys/devices/system/node/"; }
+
+            /**
+             *  All online logical CPUs.
+             */
+            inline std::vector<int> online_cpus() { return read_cpu_list(sysfs_cpu_root() + "online"); }
+
+            /**
+             *  Logical CPUs of the given NUMA node.
+             */
+            inline std::vector<int> numa_node_cpus(int node) {
+                return read_cpu_list(sysfs_node_root() + "node" + std::to_string(node) + "/cpulist");
+            }
+
+            /**
+             *  Logical CPUs of the given socket (physical package).
+             */
+            inline std::vector<int> package_cpus(int package) {
+                std::vector<int> res;
+                for (int cpu : online_cpus()) {
+                    std::ifstream file(
+                        sysfs_cpu_root() + "cpu" + std::to_string(cpu) + "/topology/physical_package_id");
+                    int id;
+                    if (file >> id && id == package)
+                        res.push_back(cpu);
+                }
+                return res;
+            }
+
+            /**
+             *  Keeps only the first hardware thread (SMT sibling) of every core.
+             */
+            inline std::vector<int> first_core_siblings(std::vector<int> const &cpus) {
+                std::vector<int> res;
+                for (int cpu : cpus) {
+                    auto siblings = read_cpu_list(
+                        sysfs_cpu_root() + "cpu" + std::to_string(cpu) + "/topology/thread_siblings_list");
+                    if (siblings.empty() || siblings.front() == cpu)
+                        res.push_back(cpu);
+                }
+                return res;
+            }
+
+            /**
+             *  Returns `cpus` without the elements of `excluded`.
+             */
+            inline std::vector<int> exclude(std::vector<int> cpus, std::vector<int> const &excluded) {
+                cpus.erase(std::remove_if(cpus.begin(),
+                               cpus.end(),
+                               [&](int cpu) {
+                                   return std::find(excluded.begin(), excluded.end(), cpu) != excluded.end();
+                               }),
+                    cpus.end());
+                return cpus;
+            }
+
+#ifdef __linux__
+            inline std::vector<int> affinity_of(pid_t pid) {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                if (sched_getaffinity(pid, sizeof(set), &set) != 0)
+                    return {};
+                std::vector<int> res;
+                for (int cpu = 0; cpu != CPU_SETSIZE; ++cpu)
+                    if (CPU_ISSET(cpu, &set))
+                        res.push_back(cpu);
+                return res;
+            }
+#endif
+
+            /**
+             *  The logical CPUs the process may run on (the affinity mask of its main thread), which may be fewer
+             *  than the online ones under cgroup or cpuset limits. Returns an empty list if it is not supported.
+             */
+            inline std::vector<int> allowed_cpus() {
+#ifdef __linux__
+                return affinity_of(getpid());
+#else
+                return {};
+#endif
+            }
+
+            /**
+             *  The logical CPUs the calling thread may run on. Returns an empty list if it is not supported.
+             */
+            inline std::vector<int> current_thread_cpus() {
+#ifdef __linux__
+                return affinity_of(0);
+#else
+                return {};
+#endif
+            }
+
+            /**
+             *  Restricts the calling thread to the given logical CPUs. Returns false if pinning is not supported or
+             *  failed.
+             */
+            inline bool pin_current_thread(std::vector<int> const &cpus) {
+#ifdef __linux__
+                if (cpus.empty())
+                    return false;
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                for (int cpu : cpus)
+                    CPU_SET(cpu, &set);
+                return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+                return false;
+#endif
+            }
+
+            /**
+             *  Pins the calling thread to the given logical CPU. Returns false if pinning is not supported or failed.
+             */
+            inline bool pin_current_thread(int cpu) { return pin_current_thread(std::vector<int>{cpu}); }
+        } // namespace affinity
+    }     // namespace thread_pool
+} // namespace gridtools
@@ -10,20 +10,111 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+#include <hpx/include/parallel_executor_parameters.hpp>
 #include <hpx/include/parallel_for_loop.hpp>
 #include <hpx/include/runtime.hpp>
 
 namespace gridtools {
     namespace thread_pool {
-        struct hpx {
+        namespace hpx_impl_ {
+            /*
+             *  Splits `total` iterations into contiguous chunks, so that every worker thread gets about
+             *  `TasksPerThread` of them. One HPX task is spawned per chunk.
+             */
+            template <size_t TasksPerThread, class I>
+            I chunk_size(I total) {
+                I num_chunks = ::hpx::get_num_worker_threads() * TasksPerThread;
+                return std::max(I(1), (total + num_chunks - 1) / num_chunks);
+            }
+
+            template <class F, class I>
+            void for_chunks(F const &f, I total, I chunk) {
+                I num_chunks = (total + chunk - 1) / chunk;
+                ::hpx::parallel::for_loop(
+                    ::hpx::parallel::execution::par.with(::hpx::parallel::execution::static_chunk_size(1)),
+                    I(0),
+                    num_chunks,
+                    [&](I c) { f(c * chunk, std::min(total, (c + 1) * chunk)); });
+            }
+        } // namespace hpx_impl_
+
+        /*
+         *  HPX thread pool.
+         *
+         *  Multidimensional loops are linearized, but the linear index is decoded only once per chunk.
+         *  Within a chunk the indices are incremented as a counter, so there is no division per iteration.
+         *
+         *  `TasksPerThread` controls the granularity: the iteration space is cut into
+         *  `TasksPerThread * hpx::get_num_worker_threads()` static chunks.
+         */
+        template <size_t TasksPerThread>
+        struct basic_hpx {
+            static_assert(TasksPerThread > 0, "TasksPerThread should be positive");
 
-            friend auto thread_pool_get_thread_num(hpx) { return ::hpx::get_worker_thread_num(); }
-            friend auto thread_pool_get_max_threads(hpx) { return ::hpx::get_num_worker_threads(); }
+            friend auto thread_pool_get_thread_num(basic_hpx) { return ::hpx::get_worker_thread_num(); }
+            friend auto thread_pool_get_max_threads(basic_hpx) { return ::hpx::get_num_worker_threads(); }
 
             template <class F, class I>
-            friend void thread_pool_parallel_for_loop(hpx, F const &f, I lim) {
-                ::hpx::parallel::for_loop(::hpx::parallel::execution::par, 0, lim, f);
+            friend void thread_pool_parallel_for_loop(basic_hpx, F const &f, I lim) {
+                hpx_impl_::for_chunks(
+                    [&](I first, I last) {
+                        for (I i = first; i < last; ++i)
+                            f(i);
+                    },
+                    lim,
+                    hpx_impl_::chunk_size<TasksPerThread>(lim));
+            }
+
+            template <class F, class I, class J>
+            friend void thread_pool_parallel_for_loop(basic_hpx, F const &f, I i_lim, J j_lim) {
+                using size_type = std::common_type_t<I, J>;
+                size_type total = size_type(i_lim) * j_lim;
+                hpx_impl_::for_chunks(
+                    [&](size_type first, size_type last) {
+                        I i = first % i_lim;
+                        J j = first / i_lim;
+                        for (size_type n = first; n < last; ++n) {
+                            f(i, j);
+                            if (++i == i_lim) {
+                                i = 0;
+                                ++j;
+                            }
+                        }
+                    },
+                    total,
+                    hpx_impl_::chunk_size<TasksPerThread>(total));
+            }
+
+            template <class F, class I, class J, class K>
+            friend void thread_pool_parallel_for_loop(basic_hpx, F const &f, I i_lim, J j_lim, K k_lim) {
+                using size_type = std::common_type_t<I, J, K>;
+                size_type ij_lim = size_type(i_lim) * j_lim;
+                size_type total = ij_lim * k_lim;
+                hpx_impl_::for_chunks(
+                    [&](size_type first, size_type last) {
+                        I i = first % i_lim;
+                        J j = first / i_lim % j_lim;
+                        K k = first / ij_lim;
+                        for (size_type n = first; n < last; ++n) {
+                            f(i, j, k);
+                            if (++i == i_lim) {
+                                i = 0;
+                                if (++j == j_lim) {
+                                    j = 0;
+                                    ++k;
+                                }
+                            }
+                        }
+                    },
+                    total,
+                    hpx_impl_::chunk_size<TasksPerThread>(total));
             }
         };
+
+        using hpx = basic_hpx<4>;
     } // namespace thread_pool
 } // namespace gridtools
@@ -0,0 +1,148 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <stdexcept>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "affinity.hpp"
+
+namespace gridtools {
+    namespace thread_pool {
+        namespace omp_core_group_impl_ {
+            /*
+             *  The group and the CPU the calling thread was last pinned to, shared by all the groups.
+             */
+            struct pinned_state {
+                void const *group = nullptr;
+                int cpu = -1;
+            };
+
+            inline pinned_state &current_pinned_state() {
+                thread_local pinned_state res;
+                return res;
+            }
+
+            /*
+             *  Restores the affinity of the thread that starts a parallel loop when the loop ends.
+             */
+            class affinity_guard {
+                std::vector<int> m_cpus = affinity::current_thread_cpus();
+
+              public:
+                affinity_guard() = default;
+                affinity_guard(affinity_guard const &) = delete;
+                affinity_guard &operator=(affinity_guard const &) = delete;
+                ~affinity_guard() {
+                    affinity::pin_current_thread(m_cpus);
+                    current_pinned_state() = {};
+                }
+            };
+        } // namespace omp_core_group_impl_
+
+        /*
+         *  OpenMP thread pool that runs on a fixed group of logical CPUs.
+         *
+         *  `CoreGroup` is a user type with a static function `cores()` that returns the list of logical CPU ids
+         *  (`std::vector<int>`) the pool should use. The list is queried once, on the first use of the pool.
+         *  Every parallel loop uses exactly one OpenMP thread per listed CPU; thread `n` of the team is pinned
+         *  to `cores()[n]`. Since OpenMP reuses its threads, a worker thread is pinned again only when it runs for
+         *  another group or on another CPU. The thread that starts the loop gets its previous affinity back when
+         *  the loop ends, so the code that runs after the loop is not restricted to the first CPU of the group.
+         *
+         *  Example: keep stencils off the first CPU of every socket.
+         *
+         *  struct compute_cores {
+         *      static std::vector<int> cores() {
+         *          auto socket0 = affinity::package_cpus(0);
+         *          auto socket1 = affinity::package_cpus(1);
+         *          return affinity::exclude(affinity::online_cpus(), {socket0.front(), socket1.front()});
+         *      }
+         *  };
+         *  using backend_t = stencil::cpu_ifirst<thread_pool::omp_core_group<compute_cores>>;
+         */
+        template <class CoreGroup>
+        struct omp_core_group {
+            static std::vector<int> const &cores() {
+                static std::vector<int> const res = [] {
+                    auto cores = CoreGroup::cores();
+                    if (cores.empty())
+                        throw std::runtime_error("omp_core_group: empty core list");
+                    return cores;
+                }();
+                return res;
+            }
+
+#ifdef _OPENMP
+          private:
+            static void pin() {
+                auto &state = omp_core_group_impl_::current_pinned_state();
+                void const *group = &cores();
+                int cpu = cores()[omp_get_thread_num()];
+                if (group == state.group && cpu == state.cpu)
+                    return;
+                affinity::pin_current_thread(cpu);
+                state.group = group;
+                state.cpu = cpu;
+            }
+
+            static int num_threads() { return cores().size(); }
+
+          public:
+            friend auto thread_pool_get_thread_num(omp_core_group) { return omp_get_thread_num(); }
+            friend auto thread_pool_get_max_threads(omp_core_group) { return num_threads(); }
+
+            template <class F, class I>
+            friend void thread_pool_parallel_for_loop(omp_core_group, F const &f, I lim) {
+                omp_core_group_impl_::affinity_guard guard;
+#pragma omp parallel num_threads(num_threads())
+                {
+                    pin();
+#pragma omp for schedule(static)
+                    for (I i = 0; i < lim; ++i)
+                        f(i);
+                }
+            }
+
+            template <class F, class I, class J>
+            friend void thread_pool_parallel_for_loop(omp_core_group, F const &f, I i_lim, J j_lim) {
+                omp_core_group_impl_::affinity_guard guard;
+#pragma omp parallel num_threads(num_threads())
+                {
+                    pin();
+#pragma omp for collapse(2) schedule(static)
+                    for (J j = 0; j < j_lim; ++j)
+                        for (I i = 0; i < i_lim; ++i)
+                            f(i, j);
+                }
+            }
+
+            template <class F, class I, class J, class K>
+            friend void thread_pool_parallel_for_loop(omp_core_group, F const &f, I i_lim, J j_lim, K k_lim) {
+                omp_core_group_impl_::affinity_guard guard;
+#pragma omp parallel num_threads(num_threads())
+                {
+                    pin();
+#pragma omp for collapse(3) schedule(static)
+                    for (K k = 0; k < k_lim; ++k)
+                        for (J j = 0; j < j_lim; ++j)
+                            for (I i = 0; i < i_lim; ++i)
+                                f(i, j, k);
+                }
+            }
+#endif
+        };
+    } // namespace thread_pool
+} // namespace gridtools
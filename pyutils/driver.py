@@ -120,6 +120,86 @@ if buildinfo:
             json.dump(data, outfile, indent='  ')
             log.info(f'Successfully saved perftests output to {output}')
 
+    @perftest.command(
+        description='run performance tests for several domain sizes and '
+        'thread counts')
+    @args.arg('--domain-size',
+              '-s',
+              required=True,
+              type=int,
+              nargs=3,
+              action='append',
+              metavar=('ISIZE', 'JSIZE', 'KSIZE'),
+              help='domain size (excluding halo), can be given several times')
+    @args.arg('--threads',
+              '-t',
+              type=int,
+              nargs='+',
+              default=[None],
+              help='numbers of OpenMP threads')
+    @args.arg('--runs',
+              default=100,
+              type=int,
+              help='number of runs to do for each stencil')
+    @args.arg('--output',
+              '-o',
+              required=True,
+              help='output file path, extension .json is added if not given')
+    def sweep(domain_size, threads, runs, output):
+
+        import perftest
+        if not output.lower().endswith('.json'):
+            output += '.json'
+
+        data = perftest.sweep(domain_size, threads, runs)
+        with open(output, 'w') as outfile:
+            json.dump(data, outfile, indent='  ')
+            log.info(f'Successfully saved perftests sweep output to {output}')
+
+
+@perftest.command(description='median and percentile times, points/s and GB/s')
+@args.arg('--input', '-i', required=True, help='output of perftest sweep')
+@args.arg('--output', '-o', help='output file path, printed if not given')
+def summary(input, output):
+    from perftest import stats
+
+    data = stats.summarize(_load_json(input))
+    if output:
+        with open(output, 'w') as outfile:
+            json.dump(data, outfile, indent='  ')
+            log.info(f'Successfully saved perftests summary to {output}')
+    else:
+        print(json.dumps(data, indent='  '))
+
+
+@perftest.command(
+    description='check for significant performance regressions, fails if '
+    'there are any')
+@args.arg('--baseline',
+          '-b',
+          required=True,
+          help='output of perftest sweep recorded on the same machine')
+@args.arg('--input', '-i', required=True, help='output of perftest sweep')
+@args.arg('--alpha',
+          type=float,
+          default=0.05,
+          help='significance level of the confidence intervals')
+@args.arg('--threshold',
+          type=float,
+          default=0.02,
+          help='smallest relative slowdown of the median that is reported, '
+          'the whole confidence interval has to be above it')
+def check(baseline, input, alpha, threshold):
+    from perftest import stats
+
+    regressions = stats.regressions(_load_json(baseline), _load_json(input),
+                                    alpha, threshold)
+    for key, ci in regressions.items():
+        log.error(f'Performance regression in {key}', str(ci))
+    if regressions:
+        raise RuntimeError(f'{len(regressions)} performance regressions')
+    log.info('No significant performance regressions')
+
 
 @perftest.command(description='plot performance results')
 def plot():
@@ -27,25 +27,62 @@ def _now():
     return datetime.now(timezone.utc).astimezone().isoformat()
 
 
-def run(domain, runs):
+def _binary():
     from pyutils import buildinfo
+    return os.path.join(buildinfo.binary_dir, 'tests', 'regression',
+                        'perftests')
+
 
-    binary = os.path.join(buildinfo.binary_dir, 'tests', 'regression',
-                          'perftests')
+def _run_binary(domain, runs, **kwargs):
+    output = runtools.srun([_binary()] + [str(d) for d in domain] +
+                           [str(runs), '-d'], **kwargs)
+    return json.loads(output)
 
-    output = runtools.srun([binary] + [str(d)
-                                       for d in domain] + [str(runs), '-d'])
-    data = json.loads(output)
 
-    data['gridtools'] = {'commit': _git_commit(), 'datetime': _git_datetime()}
-    data['environment'] = {
-        'hostname': env.hostname(),
-        'clustername': env.clustername(),
-        'compiler': buildinfo.compiler,
-        'datetime': _now(),
-        'envfile': buildinfo.envfile
+def _info():
+    from pyutils import buildinfo
+    return {
+        'gridtools': {
+            'commit': _git_commit(),
+            'datetime': _git_datetime()
+        },
+        'environment': {
+            'hostname': env.hostname(),
+            'clustername': env.clustername(),
+            'compiler': buildinfo.compiler,
+            'datetime': _now(),
+            'envfile': buildinfo.envfile
+        }
     }
+
+
+def run(domain, runs):
+    data = _run_binary(domain, runs)
+    data.update(_info())
     data['domain'] = list(domain)
     log.debug('Perftests data', pprint.pformat(data))
 
     return data
+
+
+def sweep(domains, threads, runs):
+    """Runs the perftests for all combinations of domains and thread counts.
+
+    The thread count is set with `OMP_NUM_THREADS`, the default of the
+    OpenMP runtime is used if it is `None`.
+    """
+    data = _info()
+    data['runs'] = []
+    for domain in domains:
+        for nthreads in threads:
+            run_env = env.env.copy()
+            if nthreads is not None:
+                run_env['OMP_NUM_THREADS'] = str(nthreads)
+            outputs = _run_binary(domain, runs, env=run_env)['outputs']
+            data['runs'].append({
+                'domain': list(domain),
+                'threads': nthreads,
+                'outputs': outputs
+            })
+    log.debug('Perftests sweep data', pprint.pformat(data))
+    return data
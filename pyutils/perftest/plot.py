@@ -12,6 +12,7 @@ import numpy as np
 
 from pyutils import log
 from perftest import html
+from perftest.stats import ConfidenceInterval as _ConfidenceInterval
 
 plt.style.use('ggplot')
 
@@ -31,86 +32,11 @@ class _OutputKey(typing.NamedTuple):
     def outputs_by_key(cls, data):
         def split_output(o):
             return cls(**{k: v
-                          for k, v in o.items() if k != 'series'}), o['series']
+                          for k, v in o.items() if k in cls._fields}), o['series']
 
         return dict(split_output(o) for o in data['outputs'])
 
 
-class _ConfidenceInterval(typing.NamedTuple):
-    lower: float
-    upper: float
-
-    def classify(self):
-        assert self.lower <= self.upper
-
-        # large uncertainty
-        if self.upper - self.lower > 0.1:
-            return '??'
-
-        # no change
-        if -0.01 <= self.lower <= 0 <= self.upper <= 0.01:
-            return '='
-        if -0.02 <= self.lower <= self.upper <= 0.02:
-            return '(=)'
-
-        # probably no change, but quite large uncertainty
-        if -0.05 <= self.lower <= 0 <= self.upper <= 0.05:
-            return '?'
-
-        # faster
-        if -0.01 <= self.lower <= 0.0:
-            return '(+)'
-        if -0.05 <= self.lower <= -0.01:
-            return '+'
-        if -0.1 <= self.lower <= -0.05:
-            return '++'
-        if self.lower <= -0.1:
-            return '+++'
-
-        # slower
-        if 0.01 >= self.upper >= 0.0:
-            return '(-)'
-        if 0.05 >= self.upper >= 0.01:
-            return '-'
-        if 0.1 >= self.upper >= 0.05:
-            return '--'
-        if self.upper >= 0.1:
-            return '---'
-
-        # no idea
-        return '???'
-
-    def significant(self):
-        return '=' not in self.classify()
-
-    def __str__(self):
-        assert self.lower <= self.upper
-        plower, pupper = 100 * self.lower, 100 * self.upper
-
-        if self.lower <= 0 and self.upper <= 0:
-            return f'{-pupper:3.1f}% – {-plower:3.1f}% faster'
-        if self.lower >= 0 and self.upper >= 0:
-            return f'{plower:3.1f}% – {pupper:3.1f}% slower'
-        return f'{-plower:3.1f}% faster – {pupper:3.1f}% slower'
-
-    @classmethod
-    def compare_medians(cls, before, after, n=1000, alpha=0.05):
-        scale = np.median(before)
-        before = np.asarray(before) / scale
-        after = np.asarray(after) / scale
-        # bootstrap sampling
-        before_samples = np.random.choice(before, (before.size, n))
-        after_samples = np.random.choice(after, (after.size, n))
-        # bootstrap estimates of difference of medians
-        bootstrap_estimates = (np.median(after_samples, axis=0) -
-                               np.median(before_samples, axis=0))
-        # percentile bootstrap confidence interval
-        ci = np.quantile(bootstrap_estimates, [alpha / 2, 1 - alpha / 2])
-        log.debug(f'Boostrap results (n = {n}, alpha = {alpha})',
-                  f'{ci[0]:8.5f} - {ci[1]:8.5f}')
-        return cls(*ci)
-
-
 def _add_comparison_table(report, cis):
     names = list(sorted(set(k.name for k in cis.keys())))
     backends = list(sorted(set(k.backend for k in cis.keys())))
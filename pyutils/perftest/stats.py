@@ -0,0 +1,168 @@
+# -*- coding: utf-8 -*-
+
+import typing
+
+import numpy as np
+
+from pyutils import log
+
+
+class ConfidenceInterval(typing.NamedTuple):
+    lower: float
+    upper: float
+
+    def classify(self):
+        assert self.lower <= self.upper
+
+        # large uncertainty
+        if self.upper - self.lower > 0.1:
+            return '??'
+
+        # no change
+        if -0.01 <= self.lower <= 0 <= self.upper <= 0.01:
+            return '='
+        if -0.02 <= self.lower <= self.upper <= 0.02:
+            return '(=)'
+
+        # probably no change, but quite large uncertainty
+        if -0.05 <= self.lower <= 0 <= self.upper <= 0.05:
+            return '?'
+
+        # faster
+        if -0.01 <= self.lower <= 0.0:
+            return '(+)'
+        if -0.05 <= self.lower <= -0.01:
+            return '+'
+        if -0.1 <= self.lower <= -0.05:
+            return '++'
+        if self.lower <= -0.1:
+            return '+++'
+
+        # slower
+        if 0.01 >= self.upper >= 0.0:
+            return '(-)'
+        if 0.05 >= self.upper >= 0.01:
+            return '-'
+        if 0.1 >= self.upper >= 0.05:
+            return '--'
+        if self.upper >= 0.1:
+            return '---'
+
+        # no idea
+        return '???'
+
+    def significant(self):
+        return '=' not in self.classify()
+
+    def is_regression(self, threshold):
+        """Whether the slowdown is larger than the relative `threshold`.
+
+        The whole interval has to be above the threshold, so that a slowdown
+        that is statistically significant but smaller than the threshold, like
+        the noise of a shared machine, is not reported.
+        """
+        return self.lower > threshold
+
+    def __str__(self):
+        assert self.lower <= self.upper
+        plower, pupper = 100 * self.lower, 100 * self.upper
+
+        if self.lower <= 0 and self.upper <= 0:
+            return f'{-pupper:3.1f}% – {-plower:3.1f}% faster'
+        if self.lower >= 0 and self.upper >= 0:
+            return f'{plower:3.1f}% – {pupper:3.1f}% slower'
+        return f'{-plower:3.1f}% faster – {pupper:3.1f}% slower'
+
+    @classmethod
+    def compare_medians(cls, before, after, n=1000, alpha=0.05):
+        scale = np.median(before)
+        before = np.asarray(before) / scale
+        after = np.asarray(after) / scale
+        # bootstrap sampling
+        before_samples = np.random.choice(before, (before.size, n))
+        after_samples = np.random.choice(after, (after.size, n))
+        # bootstrap estimates of difference of medians
+        bootstrap_estimates = (np.median(after_samples, axis=0) -
+                               np.median(before_samples, axis=0))
+        # percentile bootstrap confidence interval
+        ci = np.quantile(bootstrap_estimates, [alpha / 2, 1 - alpha / 2])
+        log.debug(f'Boostrap results (n = {n}, alpha = {alpha})',
+                  f'{ci[0]:8.5f} - {ci[1]:8.5f}')
+        return cls(*ci)
+
+
+class RunKey(typing.NamedTuple):
+    name: str
+    backend: str
+    float_type: str
+    domain: typing.Tuple[int, int, int]
+    threads: int
+
+    def __str__(self):
+        domain = 'x'.join(str(d) for d in self.domain)
+        return (f'{self.name} ({self.backend}, {self.float_type}, '
+                f'{domain}, {self.threads} threads)')
+
+    @classmethod
+    def series_by_key(cls, data):
+        return {
+            cls(name=o['name'],
+                backend=o['backend'],
+                float_type=o['float_type'],
+                domain=tuple(run['domain']),
+                threads=run['threads']): o
+            for run in data['runs'] for o in run['outputs']
+        }
+
+
+def summary(output, percentiles=(10, 90)):
+    """Statistics of a single output of the perftests binary.
+
+    The medians and percentiles are more robust against the outliers that are
+    typical for timings than the mean and the standard deviation.
+    """
+    series = np.asarray(output['series'])
+    median = np.median(series)
+    res = {
+        'runs': series.size,
+        'median': median,
+        **{
+            f'p{p}': v
+            for p, v in zip(percentiles, np.percentile(series, percentiles))
+        }
+    }
+    if output.get('points'):
+        res['points_per_second'] = output['points'] / median
+    if output.get('bytes'):
+        res['gb_per_second'] = output['bytes'] / median / 1e9
+    return res
+
+
+def summarize(data):
+    return [{
+        **key._asdict(), 'domain': list(key.domain),
+        **summary(output)
+    } for key, output in sorted(RunKey.series_by_key(data).items())]
+
+
+def regressions(baseline, current, alpha=0.05, threshold=0.02):
+    """Significantly slower outputs of `current` compared to `baseline`.
+
+    An output is reported if the confidence interval of the relative change of
+    its median (at the significance level `alpha`) lies entirely above
+    `threshold`, 2% by default.
+    """
+    baseline = RunKey.series_by_key(baseline)
+    current = RunKey.series_by_key(current)
+    res = dict()
+    for key, output in current.items():
+        if key not in baseline:
+            log.warning(f'No baseline for {key}')
+            continue
+        ci = ConfidenceInterval.compare_medians(baseline[key]['series'],
+                                                output['series'],
+                                                alpha=alpha)
+        log.debug(f'{key}: {ci}')
+        if ci.is_regression(threshold):
+            res[key] = ci
+    return res
@@ -0,0 +1,54 @@
+# -*- coding: utf-8 -*-
+
+import unittest
+from unittest import mock
+
+from perftest import stats
+
+
+def _data(series):
+    return {
+        'runs': [{
+            'domain': [64, 64, 60],
+            'threads': 4,
+            'outputs': [{
+                'name': 'copy_stencil',
+                'backend': 'cpu_kfirst',
+                'float_type': 'float',
+                'series': series
+            }]
+        }]
+    }
+
+
+class TestRegressions(unittest.TestCase):
+    def check(self, lower, upper, threshold=0.02):
+        ci = stats.ConfidenceInterval(lower, upper)
+        with mock.patch.object(stats.ConfidenceInterval,
+                               'compare_medians',
+                               return_value=ci):
+            return stats.regressions(_data([1.0]),
+                                     _data([1.1]),
+                                     threshold=threshold)
+
+    def test_noise_is_not_reported(self):
+        # significant, but below one percent
+        self.assertFalse(self.check(0.002, 0.009))
+
+    def test_at_threshold(self):
+        self.assertFalse(self.check(0.02, 0.03))
+        self.assertTrue(self.check(0.0201, 0.03))
+
+    def test_interval_across_threshold(self):
+        self.assertFalse(self.check(0.01, 0.08))
+
+    def test_custom_threshold(self):
+        self.assertTrue(self.check(0.06, 0.08, threshold=0.05))
+        self.assertFalse(self.check(0.04, 0.08, threshold=0.05))
+
+    def test_faster(self):
+        self.assertFalse(self.check(-0.08, -0.03))
+
+
+if __name__ == '__main__':
+    unittest.main()
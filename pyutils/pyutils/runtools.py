@@ -13,8 +13,10 @@ async def _run_async(command, log_output, **kwargs):
         *command,
         stdout=asyncio.subprocess.PIPE,
         stderr=asyncio.subprocess.PIPE,
-        env=env.env,
-        **kwargs)
+        **{
+            'env': env.env,
+            **kwargs
+        })
 
     async def read_output(stream):
         buffer = io.StringIO()
@@ -39,7 +39,7 @@ namespace {
 namespace gridtools {
     namespace gcl {
         storage::cpu_ifirst backend_storage_traits(cpu const &);
-        timer_omp backend_timer_impl(cpu const &);
+        timer_cpu backend_timer_impl(cpu const &);
         inline char const *backend_name(cpu const &) { return "cpu"; }
 
         storage::gpu backend_storage_traits(gpu const &);
@@ -142,7 +142,7 @@ namespace gridtools {
             storage::cpu_kfirst backend_storage_traits(cpu_kfirst<I, J, T>);
 
             template <class I, class J, class T>
-            timer_omp backend_timer_impl(cpu_kfirst<I, J, T>);
+            timer_cpu backend_timer_impl(cpu_kfirst<I, J, T>);
 
             template <class I, class J, class T>
             char const *backend_name(cpu_kfirst<I, J, T> const &) {
@@ -178,7 +178,7 @@ namespace gridtools {
             std::false_type backend_supports_icosahedral(cpu_ifirst<T>);
 
             template <class T>
-            timer_omp backend_timer_impl(cpu_ifirst<T>);
+            timer_cpu backend_timer_impl(cpu_ifirst<T>);
 
             template <class T>
             char const *backend_name(cpu_ifirst<T> const &) {
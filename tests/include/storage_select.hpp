@@ -38,8 +38,8 @@ namespace gridtools {
         cpu_kfirst backend_storage_traits(cpu_kfirst const &);
         cpu_ifirst backend_storage_traits(cpu_ifirst const &);
 
-        timer_omp backend_timer_impl(cpu_kfirst const &);
-        timer_omp backend_timer_impl(cpu_ifirst const &);
+        timer_cpu backend_timer_impl(cpu_kfirst const &);
+        timer_cpu backend_timer_impl(cpu_ifirst const &);
         timer_cuda backend_timer_impl(gpu const &);
 
         inline char const *backend_name(cpu_kfirst const &) { return "cpu_kfirst"; }
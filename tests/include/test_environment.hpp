@@ -9,7 +9,9 @@
  */
 #pragma once
 
+#include <array>
 #include <cstdlib>
+#include <initializer_list>
 #include <string>
 #include <type_traits>
 #include <typeinfo>
@@ -109,9 +111,32 @@ namespace gridtools {
         inline void flush_cache(T const &) {}
 
         void flush_cache(timer_omp const &);
+        void flush_cache(timer_perf const &);
 
         void add_time(std::string const &name, std::string const &backend, std::string const &float_type, double time);
 
+        void add_counters(
+            std::string const &name, std::string const &backend, std::string const &float_type, std::string counters);
+
+        void add_sizes(std::string const &name,
+            std::string const &backend,
+            std::string const &float_type,
+            size_t points,
+            size_t bytes);
+
+        // the timers with hardware counters report them once per benchmark
+        template <class Timer>
+        auto report_counters(std::string const &name,
+            std::string const &backend,
+            std::string const &float_type,
+            Timer const &timer,
+            int) -> decltype(void(timer.to_string_impl())) {
+            add_counters(name, backend, float_type, timer.to_string_impl());
+        }
+
+        template <class Timer>
+        void report_counters(std::string const &, std::string const &, std::string const &, Timer const &, long) {}
+
         struct cmdline_params {
             static int d(size_t i);
             static size_t steps();
@@ -210,6 +235,39 @@ namespace gridtools {
                     return make_storage<T const>(arg);
                 }
 
+                /**
+                 *  Makes a data store for every initializer. If the storage supports it, the rows of the data stores
+                 *  are interleaved in memory.
+                 */
+                template <class T = FloatType, class... Funs>
+                static auto make_interleaved_storages(Funs const &... funs) {
+                    return make_interleaved_storages_impl<T>(
+                        bool_constant<storage::traits::is_host_referenceable<storage_traits_t>>(), funs...);
+                }
+
+                template <class T, class... Funs>
+                static auto make_interleaved_storages_impl(std::true_type, Funs const &... funs) {
+                    auto res = builder<T>().template build_interleaved<sizeof...(Funs)>();
+                    size_t n = 0;
+                    (void)std::initializer_list<int>{(fill(*res[n++], funs), 0)...};
+                    return res;
+                }
+
+                template <class T, class... Funs>
+                static auto make_interleaved_storages_impl(std::false_type, Funs const &... funs) {
+                    return std::array<decltype(make_storage<T>()), sizeof...(Funs)>{make_storage<T>(funs)...};
+                }
+
+                template <class DataStore, class Fun>
+                static void fill(DataStore &ds, Fun const &fun) {
+                    auto view = ds.host_view();
+                    auto lengths = ds.lengths();
+                    for (int i = 0; i < lengths[0]; ++i)
+                        for (int j = 0; j < lengths[1]; ++j)
+                            for (int k = 0; k < lengths[2]; ++k)
+                                view(i, j, k) = fun(i, j, k);
+                }
+
                 template <class T = FloatType, class Location>
                 static auto icosahedral_builder(Location) {
                     return storage::builder<storage_traits_t>              //
@@ -240,11 +298,22 @@ namespace gridtools {
                     return icosahedral_builder<T>(loc).value(arg).build();
                 }
 
+                /**
+                 *  `num_fields` is the number of fields of `FloatType` that are streamed once through the memory by
+                 *  a call of `comp`. It is used to report the achieved memory bandwidth. A field on cells counts
+                 *  twice and a field on edges three times, once per color.
+                 */
                 template <class Comp>
-                static void benchmark(std::string const &name, Comp &&comp) {
+                static void benchmark(std::string const &name, Comp &&comp, size_t num_fields = 0) {
                     size_t steps = ParamsSource::steps();
                     if (steps == 0 || backend_skip_benchmark(Backend()))
                         return;
+                    size_t points = ParamsSource::d(0) * ParamsSource::d(1) * ParamsSource::d(2);
+                    add_sizes(name,
+                        backend_name(Backend()),
+                        float_type_name(),
+                        points,
+                        num_fields * points * sizeof(FloatType));
                     comp();
                     timer_impl_t timer;
                     for (size_t i = 0; i != steps; ++i) {
@@ -254,6 +323,7 @@ namespace gridtools {
                         auto time = timer.pause_impl();
                         add_time(name, backend_name(Backend()), float_type_name(), time);
                     }
+                    report_counters(name, backend_name(Backend()), float_type_name(), timer, 0);
                 }
 
                 static auto test_name() {
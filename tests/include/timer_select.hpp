@@ -13,8 +13,20 @@ namespace gridtools {
     class timer_cuda;
     class timer_omp;
     struct timer_dummy;
+    class timer_perf;
+
+    // the timer of the CPU backends; hardware counters are used if `GT_TIMER_PERF` is defined
+#ifdef GT_TIMER_PERF
+    using timer_cpu = timer_perf;
+#else
+    using timer_cpu = timer_omp;
+#endif
 } // namespace gridtools
 
+#ifdef GT_TIMER_PERF
+#include <gridtools/common/timer/timer_perf.hpp>
+#endif
+
 // default timer implementation
 #if defined(GT_TIMER_CUDA)
 #include <gridtools/common/timer/timer_cuda.hpp>
@@ -84,7 +84,7 @@ namespace gridtools {
 
         template <class DataStore>
         using default_equal_to =
-            meta::if_<std::is_floating_point<typename DataStore::data_t>, float_equal_to, std::equal_to<>>;
+            meta::if_<std::is_floating_point<typename DataStore::compute_t>, float_equal_to, std::equal_to<>>;
 
         template <class Expected, class DataStore, class Halos, class EqualTo = default_equal_to<DataStore>>
         std::enable_if_t<storage::is_data_store<DataStore>::value &&
@@ -102,7 +102,7 @@ namespace gridtools {
             static constexpr size_t err_lim = 20;
             size_t err_count = 0;
             for (auto &&pos : make_hypercube_view(bounds)) {
-                auto a = verify_impl_::apply(view, pos);
+                typename DataStore::compute_t a = verify_impl_::apply(view, pos);
                 decltype(a) e = verify_impl_::apply(expected, pos);
                 if (equal_to(e, a))
                     continue;
@@ -55,6 +55,6 @@ namespace {
         for (size_t i = 0; i != out.size(); ++i)
             TypeParam::verify([i](int, int, int) { return 1.1 * i; }, out[i]);
 
-        TypeParam::benchmark("advection_pdbott_prepare_tracers", comp);
+        TypeParam::benchmark("advection_pdbott_prepare_tracers", comp, 2 * in.size() + 1);
     }
 } // namespace
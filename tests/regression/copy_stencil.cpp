@@ -40,6 +40,6 @@ namespace {
         };
         comp();
         TypeParam::verify(in, out);
-        TypeParam::benchmark("copy_stencil", comp);
+        TypeParam::benchmark("copy_stencil", comp, 2);
     }
 } // namespace
\ No newline at end of file
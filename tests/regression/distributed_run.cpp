@@ -0,0 +1,287 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/boundaries/distributed_run.hpp>
+
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <gridtools/boundaries/comm_traits.hpp>
+#include <gridtools/stencil/cartesian.hpp>
+#include <gridtools/stencil/naive.hpp>
+#include <gridtools/storage/builder.hpp>
+#include <gridtools/storage/sid.hpp>
+
+#include <gcl_select.hpp>
+#include <stencil_select.hpp>
+#include <storage_select.hpp>
+#include <timer_select.hpp>
+
+/*
+  A laplacian on a periodic domain that is distributed over the processes. Only the halo of the field that is read
+  with a non-zero extent is exchanged; the halo of the field that is read at zero offset keeps its initial value.
+
+  An in-place update of a field that is read at an offset is exchanged too.
+
+  Then the time steps of a diffusion-like stencil with halos three times wider than its extent, where the halos are
+  exchanged once every three steps, on a periodic and on a non-periodic domain. The values are integers, so that the
+  result is exact.
+ */
+
+namespace {
+    using namespace gridtools;
+    using namespace stencil;
+    using namespace cartesian;
+
+    constexpr int halo = 1;
+    constexpr int d1 = 9;
+    constexpr int d2 = 7;
+    constexpr int d3 = 4;
+
+    constexpr double sentinel = -1;
+
+    struct lap_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+        using coeff = in_accessor<2>;
+        using param_list = make_param_list<out, in, coeff>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(out()) = eval(coeff()) * (4 * eval(in()) -
+                                              (eval(in(1, 0)) + eval(in(0, 1)) + eval(in(-1, 0)) + eval(in(0, -1))));
+        }
+    };
+
+    const auto builder = storage::builder<storage_traits_t>.type<double>().dimensions(
+        d1 + 2 * halo, d2 + 2 * halo, d3);
+
+    using storage_t = decltype(builder());
+    using testee_t = boundaries::distributed_boundaries<boundaries::comm_traits<storage_t, gcl_arch_t, timer_impl_t>>;
+
+    TEST(distributed_run, laplacian) {
+        auto total_lengths = storage::make_total_lengths(*builder());
+        array<halo_descriptor, 3> halos{{{halo, halo, halo, d1 + halo - 1, total_lengths[0]},
+            {halo, halo, halo, d2 + halo - 1, total_lengths[1]},
+            {0, 0, 0, d3 - 1, total_lengths[2]}}};
+
+        testee_t dist_bc(halos, {true, true, false}, 3, [] {
+            int dims[3] = {0, 0, 1};
+            MPI_Dims_create(gcl::procs(), 3, dims);
+            int period[3] = {1, 1, 1};
+            MPI_Comm res;
+            MPI_Cart_create(gcl::world(), 3, dims, period, false, &res);
+            return res;
+        }());
+
+        int pi, pj, pk, PI, PJ, PK;
+        dist_bc.proc_grid().coords(pi, pj, pk);
+        dist_bc.proc_grid().dims(PI, PJ, PK);
+
+        auto global = [&](int i, int j, int k) {
+            int I = (pi * d1 + i - halo + PI * d1) % (PI * d1);
+            int J = (pj * d2 + j - halo + PJ * d2) % (PJ * d2);
+            return I * I + 3. * J + .5 * k;
+        };
+        auto core = [](int i, int j) { return i >= halo && i < d1 + halo && j >= halo && j < d2 + halo; };
+
+        auto in = builder.initializer([&](int i, int j, int k) { return core(i, j) ? global(i, j, k) : sentinel; })();
+        auto coeff = builder.initializer([&](int i, int j, int) { return core(i, j) ? 2. : sentinel; })();
+        auto out = builder.value(sentinel)();
+
+        auto grid = make_grid(halos[0], halos[1], d3);
+        auto spec = [](auto out, auto in, auto coeff) {
+            return execute_parallel().stage(lap_function(), out, in, coeff);
+        };
+        boundaries::distributed_run(dist_bc, spec, stencil_backend_t(), grid, out, in, coeff);
+
+        auto out_v = out->const_host_view();
+        auto coeff_v = coeff->const_host_view();
+        for (int i = 0; i < d1 + 2 * halo; ++i)
+            for (int j = 0; j < d2 + 2 * halo; ++j)
+                for (int k = 0; k < d3; ++k) {
+                    if (!core(i, j)) {
+                        EXPECT_EQ(coeff_v(i, j, k), sentinel) << gcl::pid() << ": " << i << ", " << j << ", " << k;
+                        continue;
+                    }
+                    double expected = 2 * (4 * global(i, j, k) - (global(i + 1, j, k) + global(i, j + 1, k) +
+                                                                     global(i - 1, j, k) + global(i, j - 1, k)));
+                    EXPECT_EQ(out_v(i, j, k), expected) << gcl::pid() << ": " << i << ", " << j << ", " << k;
+                }
+    }
+
+    struct lap_tmp_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+        using param_list = make_param_list<out, in>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(out()) = 4 * eval(in()) - (eval(in(1, 0)) + eval(in(0, 1)) + eval(in(-1, 0)) + eval(in(0, -1)));
+        }
+    };
+
+    struct update_function {
+        using u = inout_accessor<0>;
+        using lap = in_accessor<1>;
+        using param_list = make_param_list<u, lap>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(u()) -= eval(lap());
+        }
+    };
+
+    TEST(distributed_run, in_place) {
+        auto total_lengths = storage::make_total_lengths(*builder());
+        array<halo_descriptor, 3> halos{{{halo, halo, halo, d1 + halo - 1, total_lengths[0]},
+            {halo, halo, halo, d2 + halo - 1, total_lengths[1]},
+            {0, 0, 0, d3 - 1, total_lengths[2]}}};
+
+        testee_t dist_bc(halos, {true, true, false}, 3, [] {
+            int dims[3] = {0, 0, 1};
+            MPI_Dims_create(gcl::procs(), 3, dims);
+            int period[3] = {1, 1, 1};
+            MPI_Comm res;
+            MPI_Cart_create(gcl::world(), 3, dims, period, false, &res);
+            return res;
+        }());
+
+        int pi, pj, pk, PI, PJ, PK;
+        dist_bc.proc_grid().coords(pi, pj, pk);
+        dist_bc.proc_grid().dims(PI, PJ, PK);
+
+        auto global = [&](int i, int j, int k) {
+            int I = (pi * d1 + i - halo + PI * d1) % (PI * d1);
+            int J = (pj * d2 + j - halo + PJ * d2) % (PJ * d2);
+            return I * I + 3. * J + .5 * k;
+        };
+        auto core = [](int i, int j) { return i >= halo && i < d1 + halo && j >= halo && j < d2 + halo; };
+
+        // `u` is read at an offset by the first stage and written by the second one
+        auto u = builder.initializer([&](int i, int j, int k) { return core(i, j) ? global(i, j, k) : sentinel; })();
+
+        auto grid = make_grid(halos[0], halos[1], d3);
+        auto spec = [](auto u) {
+            GT_DECLARE_TMP(double, lap);
+            return multi_pass(execute_parallel().stage(lap_tmp_function(), lap, u),
+                execute_parallel().stage(update_function(), u, lap));
+        };
+        // the blocked backends run all the stages of a block before the next block, they would race on `u`
+        boundaries::distributed_run(dist_bc, spec, naive(), grid, u);
+
+        auto u_v = u->const_host_view();
+        for (int i = halo; i < d1 + halo; ++i)
+            for (int j = halo; j < d2 + halo; ++j)
+                for (int k = 0; k < d3; ++k) {
+                    double lap = 4 * global(i, j, k) - (global(i + 1, j, k) + global(i, j + 1, k) +
+                                                           global(i - 1, j, k) + global(i, j - 1, k));
+                    EXPECT_EQ(u_v(i, j, k), global(i, j, k) - lap) << gcl::pid() << ": " << i << ", " << j << ", " << k;
+                }
+    }
+
+    constexpr int deep_halo = 3;
+    constexpr int steps = 7;
+
+    struct step_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+        using coeff = in_accessor<2, extent<0, 1>>;
+        using param_list = make_param_list<out, in, coeff>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(out()) = eval(coeff(1, 0)) * (eval(in(1, 0)) + eval(in(-1, 0))) + eval(in(0, 1)) + eval(in(0, -1)) -
+                          3 * eval(in());
+        }
+    };
+
+    void check_steps(bool periodic) {
+        auto builder = storage::builder<storage_traits_t>.type<double>().dimensions(
+            d1 + 2 * deep_halo, d2 + 2 * deep_halo, d3);
+        auto total_lengths = storage::make_total_lengths(*builder());
+        array<halo_descriptor, 3> halos{{{deep_halo, deep_halo, deep_halo, d1 + deep_halo - 1, total_lengths[0]},
+            {deep_halo, deep_halo, deep_halo, d2 + deep_halo - 1, total_lengths[1]},
+            {0, 0, 0, d3 - 1, total_lengths[2]}}};
+
+        testee_t dist_bc(halos, {periodic, periodic, false}, 3, [&] {
+            int dims[3] = {0, 0, 1};
+            MPI_Dims_create(gcl::procs(), 3, dims);
+            int period[3] = {periodic, periodic, 1};
+            MPI_Comm res;
+            MPI_Cart_create(gcl::world(), 3, dims, period, false, &res);
+            return res;
+        }());
+
+        int pi, pj, pk, PI, PJ, PK;
+        dist_bc.proc_grid().coords(pi, pj, pk);
+        dist_bc.proc_grid().dims(PI, PJ, PK);
+        int const gi = PI * d1;
+        int const gj = PJ * d2;
+
+        // outside of a non-periodic domain the fields keep the initial value of the halos
+        std::vector<double> ref((size_t)gi * gj * d3), tmp(ref.size()), coeff_ref(ref.size());
+        auto at = [&](std::vector<double> &v, int i, int j, int k) -> double & {
+            return v[(((i + gi) % gi) * gj + (j + gj) % gj) * d3 + k];
+        };
+        auto value = [&](std::vector<double> &v, int i, int j, int k) {
+            return periodic || (i >= 0 && i < gi && j >= 0 && j < gj) ? at(v, i, j, k) : sentinel;
+        };
+        for (int i = 0; i < gi; ++i)
+            for (int j = 0; j < gj; ++j)
+                for (int k = 0; k < d3; ++k) {
+                    at(ref, i, j, k) = (i * 7 + j * 3 + k) % 5;
+                    at(coeff_ref, i, j, k) = 1 + (i + j) % 2;
+                }
+        std::vector<double> init = ref;
+        for (int s = 0; s < steps; ++s) {
+            for (int i = 0; i < gi; ++i)
+                for (int j = 0; j < gj; ++j)
+                    for (int k = 0; k < d3; ++k)
+                        at(tmp, i, j, k) =
+                            value(coeff_ref, i + 1, j, k) * (value(ref, i + 1, j, k) + value(ref, i - 1, j, k)) +
+                            value(ref, i, j + 1, k) + value(ref, i, j - 1, k) - 3 * value(ref, i, j, k);
+            std::swap(ref, tmp);
+        }
+
+        auto global_i = [&](int i) { return pi * d1 + i - deep_halo; };
+        auto global_j = [&](int j) { return pj * d2 + j - deep_halo; };
+        auto core = [](int i, int j) {
+            return i >= deep_halo && i < d1 + deep_halo && j >= deep_halo && j < d2 + deep_halo;
+        };
+        auto from_core = [&](std::vector<double> &v) {
+            return [&](int i, int j, int k) { return core(i, j) ? at(v, global_i(i), global_j(j), k) : sentinel; };
+        };
+
+        auto in = builder.initializer(from_core(init))();
+        auto out = builder.value(sentinel)();
+        auto coeff = builder.initializer(from_core(coeff_ref))();
+
+        auto spec = [](auto out, auto in, auto coeff) {
+            return execute_parallel().stage(step_function(), out, in, coeff);
+        };
+        auto exchanges =
+            boundaries::distributed_run_steps(dist_bc, steps, spec, stencil_backend_t(), d3, out, in, coeff);
+        EXPECT_EQ(exchanges, periodic || PI > 1 || PJ > 1 ? (steps + 2) / 3 : 1);
+
+        auto in_v = in->const_host_view();
+        for (int i = deep_halo; i < d1 + deep_halo; ++i)
+            for (int j = deep_halo; j < d2 + deep_halo; ++j)
+                for (int k = 0; k < d3; ++k)
+                    EXPECT_EQ(in_v(i, j, k), at(ref, global_i(i), global_j(j), k))
+                        << gcl::pid() << ": " << i << ", " << j << ", " << k;
+    }
+
+    TEST(distributed_run, steps) { check_steps(true); }
+
+    TEST(distributed_run, steps_non_periodic) { check_steps(false); }
+} // namespace
@@ -208,6 +208,136 @@ INSTANTIATE_TEST_SUITE_P(tests,
             .halos = {{{2, 2}, {2, 2}, {2, 2}}, {{2, 2}, {2, 2}, {2, 2}}, {{2, 2}, {2, 2}, {2, 2}}},
             .mpi_dims = {2, 1}}));
 
+#ifndef GT_GCL_GPU
+struct halo_exchange_3D_dim_by_dim : halo_exchange_3D_test {};
+
+TEST_P(halo_exchange_3D_dim_by_dim, test) {
+    run_exchanges([&](auto layout, auto use_vector_interface, auto &&storages, auto periodicity) {
+        using testee_t = gcl::halo_exchange_dynamic_ut<decltype(layout),
+            layout_map<0, 1, 2>,
+            value_type,
+            gcl_arch_t,
+            gcl::dimension_by_dimension>;
+        testee_t testee(periodicity, CartComm);
+        auto halo_descriptors = make_halo_descriptors(storages, 0);
+        for_each<meta::make_indices_c<num_fields>>(
+            [&](auto f) { testee.template add_halo<decltype(f)::value>(halo_descriptors[f.value]); });
+        testee.setup(3);
+        auto field = [&](int f) { return storages[f]->get_target_ptr(); };
+        exchange(use_vector_interface, testee, field(0), field(1), field(2));
+    });
+}
+
+INSTANTIATE_TEST_SUITE_P(tests,
+    halo_exchange_3D_dim_by_dim,
+    testing::Values(test_spec{.dims = {23, 12, 7},
+                        .halos = {{{2, 3}, {1, 2}, {2, 1}}, {{2, 3}, {1, 2}, {2, 1}}, {{2, 3}, {1, 2}, {2, 1}}},
+                        .mpi_dims = {}},
+        test_spec{.dims = {12, 12, 12},
+            .halos = {{{2, 2}, {2, 2}, {2, 2}}, {{2, 2}, {2, 2}, {2, 2}}, {{2, 2}, {2, 2}, {2, 2}}},
+            .mpi_dims = {1, 2}}));
+
+struct halo_exchange_3D_progress : halo_exchange_3D_test {};
+
+TEST_P(halo_exchange_3D_progress, test) {
+    gcl::progress_thread progress;
+    run_exchanges([&](auto layout, auto, auto &&storages, auto periodicity) {
+        using testee_t = gcl::halo_exchange_dynamic_ut<decltype(layout), layout_map<0, 1, 2>, value_type, gcl_arch_t>;
+        testee_t testee(periodicity, CartComm);
+        auto halo_descriptors = make_halo_descriptors(storages, 0);
+        for_each<meta::make_indices_c<num_fields>>(
+            [&](auto f) { testee.template add_halo<decltype(f)::value>(halo_descriptors[f.value]); });
+        testee.setup(3);
+        std::vector<value_type *> fields = {
+            storages[0]->get_target_ptr(), storages[1]->get_target_ptr(), storages[2]->get_target_ptr()};
+        testee.pack(fields);
+        testee.start_exchange(progress, fields);
+        testee.wait();
+    });
+}
+
+INSTANTIATE_TEST_SUITE_P(tests,
+    halo_exchange_3D_progress,
+    testing::Values(test_spec{.dims = {23, 12, 7},
+                        .halos = {{{2, 3}, {1, 2}, {2, 1}}, {{2, 3}, {1, 2}, {2, 1}}, {{2, 3}, {1, 2}, {2, 1}}},
+                        .mpi_dims = {}},
+        test_spec{.dims = {12, 12, 12},
+            .halos = {{{2, 2}, {2, 2}, {2, 2}}, {{2, 2}, {2, 2}, {2, 2}}, {{2, 2}, {2, 2}, {2, 2}}},
+            .mpi_dims = {1, 2}}));
+
+struct halo_exchange_3D_shared_memory : halo_exchange_3D_test {
+    // pairs of processes pretend to run on the same node, so that some neighbours exchange through shared memory
+    // and others through MPI
+    MPI_Comm make_pairs() const {
+        int rank;
+        MPI_Comm_rank(CartComm, &rank);
+        MPI_Comm res;
+        MPI_Comm_split(CartComm, rank / 2, rank, &res);
+        return res;
+    }
+};
+
+TEST_P(halo_exchange_3D_shared_memory, node) {
+    run_exchanges([&](auto layout, auto use_vector_interface, auto &&storages, auto periodicity) {
+        using testee_t = gcl::halo_exchange_dynamic_ut<decltype(layout), layout_map<0, 1, 2>, value_type, gcl_arch_t>;
+        testee_t testee(periodicity, CartComm);
+        auto halo_descriptors = make_halo_descriptors(storages, 0);
+        for_each<meta::make_indices_c<num_fields>>(
+            [&](auto f) { testee.template add_halo<decltype(f)::value>(halo_descriptors[f.value]); });
+        testee.setup(3);
+        testee.enable_shared_memory();
+        auto field = [&](int f) { return storages[f]->get_target_ptr(); };
+        exchange(use_vector_interface, testee, field(0), field(1), field(2));
+        exchange(use_vector_interface, testee, field(0), field(1));
+    });
+}
+
+TEST_P(halo_exchange_3D_shared_memory, mixed_neighbours) {
+    MPI_Comm pairs = make_pairs();
+    run_exchanges([&](auto layout, auto use_vector_interface, auto &&storages, auto periodicity) {
+        using testee_t = gcl::halo_exchange_dynamic_ut<decltype(layout), layout_map<0, 1, 2>, value_type, gcl_arch_t>;
+        testee_t testee(periodicity, CartComm);
+        auto halo_descriptors = make_halo_descriptors(storages, 0);
+        for_each<meta::make_indices_c<num_fields>>(
+            [&](auto f) { testee.template add_halo<decltype(f)::value>(halo_descriptors[f.value]); });
+        testee.setup(3);
+        testee.enable_shared_memory(pairs);
+        auto field = [&](int f) { return storages[f]->get_target_ptr(); };
+        exchange(use_vector_interface, testee, field(0), field(1), field(2));
+    });
+    MPI_Comm_free(&pairs);
+}
+
+TEST_P(halo_exchange_3D_shared_memory, dim_by_dim) {
+    MPI_Comm pairs = make_pairs();
+    run_exchanges([&](auto layout, auto use_vector_interface, auto &&storages, auto periodicity) {
+        using testee_t = gcl::halo_exchange_dynamic_ut<decltype(layout),
+            layout_map<0, 1, 2>,
+            value_type,
+            gcl_arch_t,
+            gcl::dimension_by_dimension>;
+        testee_t testee(periodicity, CartComm);
+        auto halo_descriptors = make_halo_descriptors(storages, 0);
+        for_each<meta::make_indices_c<num_fields>>(
+            [&](auto f) { testee.template add_halo<decltype(f)::value>(halo_descriptors[f.value]); });
+        testee.setup(3);
+        testee.enable_shared_memory(pairs);
+        auto field = [&](int f) { return storages[f]->get_target_ptr(); };
+        exchange(use_vector_interface, testee, field(0), field(1), field(2));
+    });
+    MPI_Comm_free(&pairs);
+}
+
+INSTANTIATE_TEST_SUITE_P(tests,
+    halo_exchange_3D_shared_memory,
+    testing::Values(test_spec{.dims = {23, 12, 7},
+                        .halos = {{{2, 3}, {1, 2}, {2, 1}}, {{2, 3}, {1, 2}, {2, 1}}, {{2, 3}, {1, 2}, {2, 1}}},
+                        .mpi_dims = {}},
+        test_spec{.dims = {12, 12, 12},
+            .halos = {{{2, 2}, {2, 2}, {2, 2}}, {{2, 2}, {2, 2}, {2, 2}}, {{2, 2}, {2, 2}, {2, 2}}},
+            .mpi_dims = {4, 1}}));
+#endif
+
 struct halo_exchange_3D_generic : halo_exchange_3D_test {
     array<halo_descriptor, num_dims> make_enclosed_halo_descriptor() {
         array<halo_descriptor, num_dims> res;
@@ -231,6 +361,9 @@ TEST_P(halo_exchange_3D_generic, test) {
         testee.setup(3,
             gcl::field_on_the_fly<int, layout_t, testee_t::traits>(nullptr, make_enclosed_halo_descriptor()),
             sizeof(value_type));
+#ifndef GT_GCL_GPU
+        testee.enable_shared_memory();
+#endif
         auto field = [&](int f) {
             return gcl::field_on_the_fly<value_type, layout_t, testee_t::traits>(
                 storages[f]->get_target_ptr(), make_halo_descriptors(storages, f));
@@ -0,0 +1,150 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/gcl/load_balancer.hpp>
+
+#include <vector>
+
+#include <mpi.h>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/common/array.hpp>
+#include <gridtools/common/boollist.hpp>
+#include <gridtools/common/halo_descriptor.hpp>
+#include <gridtools/common/layout_map.hpp>
+#include <gridtools/gcl/GCL.hpp>
+#include <gridtools/gcl/halo_exchange.hpp>
+#include <gridtools/gcl/low_level/proc_grids_3D.hpp>
+
+using namespace gridtools;
+using namespace gcl;
+
+namespace {
+    constexpr int NI = 24;
+    constexpr int NJ = 20;
+    constexpr int NK = 3;
+    constexpr int H = 2;
+
+    typedef MPI_3D_process_grid_t<3> grid_type;
+    typedef array<halo_descriptor, 3> halo_block;
+
+    MPI_Comm make_comm() {
+        int dims[3] = {0, 0, 1};
+        MPI_Dims_create(procs(), 3, dims);
+        int period[3] = {1, 1, 1};
+        MPI_Comm res;
+        MPI_Cart_create(world(), 3, dims, period, false, &res);
+        return res;
+    }
+
+    double global_value(int i, int j, int k) {
+        return ((i + NI) % NI) * 1000 + ((j + NJ) % NJ) * 10 + k;
+    }
+
+    /*
+     * A local field of the block of this rank, with halos of width H in the first two dimensions
+     */
+    struct field {
+        halo_block halos;
+        array<int, 2> begin;
+        std::vector<double> data;
+
+        field(int ni, int nj, array<int, 2> const &begin)
+            : halos{halo_descriptor(H, H, H, ni + H - 1, ni + 2 * H),
+                  halo_descriptor(H, H, H, nj + H - 1, nj + 2 * H),
+                  halo_descriptor(0, 0, 0, NK - 1, NK)},
+              begin(begin), data((ni + 2 * H) * (nj + 2 * H) * NK, -1) {}
+
+        double &operator()(int i, int j, int k) {
+            return data[((i + H) * halos[1].total_length() + j + H) * NK + k];
+        }
+
+        int size(int dim) const { return halos[dim].end() - halos[dim].begin() + 1; }
+    };
+} // namespace
+
+TEST(load_balancer, balanced) {
+    MPI_Comm comm = make_comm();
+    grid_type pgrid(boollist<3>(true, true, true), comm);
+    load_balancer<grid_type> balancer(pgrid, {NI, NJ}, 2);
+
+    for (int step = 0; step < 4; ++step)
+        EXPECT_FALSE(balancer.step(1.));
+    EXPECT_TRUE(balancer.partition() == balancer.previous());
+    EXPECT_EQ(balancer.partition().global_size(0), NI);
+    EXPECT_EQ(balancer.partition().global_size(1), NJ);
+    MPI_Comm_free(&comm);
+}
+
+TEST(load_balancer, rebalance_and_migrate) {
+    MPI_Comm comm = make_comm();
+    grid_type pgrid(boollist<3>(true, true, true), comm);
+    int pi, pj, pk, PI, PJ, PK;
+    pgrid.coords(pi, pj, pk);
+    pgrid.dims(PI, PJ, PK);
+
+    constexpr int period = 3;
+    load_balancer<grid_type> balancer(pgrid, {NI, NJ}, period, 1.1, H);
+    field old_field(balancer.size(0), balancer.size(1), {balancer.begin(0), balancer.begin(1)});
+    for (int i = 0; i < old_field.size(0); ++i)
+        for (int j = 0; j < old_field.size(1); ++j)
+            for (int k = 0; k < NK; ++k)
+                old_field(i, j, k) = global_value(old_field.begin[0] + i, old_field.begin[1] + j, k);
+
+    // the first rank is three times slower than the others
+    double time = pi == 0 && pj == 0 ? 3. : 1.;
+    for (int step = 1; step < period; ++step)
+        EXPECT_FALSE(balancer.step(time));
+    bool changed = balancer.step(time);
+    if (PI * PJ == 1) {
+        EXPECT_FALSE(changed);
+        MPI_Comm_free(&comm);
+        return;
+    }
+    ASSERT_TRUE(changed);
+
+    auto const &partition = balancer.partition();
+    for (int d = 0; d < 2; ++d) {
+        int parts = partition.parts(d);
+        if (parts == 1)
+            continue;
+        EXPECT_LT(partition.size(d, 0), balancer.previous().size(d, 0));
+        for (int p = 0; p < parts; ++p)
+            EXPECT_GE(partition.size(d, p), H);
+        EXPECT_EQ(partition.global_size(d), d == 0 ? NI : NJ);
+    }
+
+    field new_field(balancer.size(0), balancer.size(1), {balancer.begin(0), balancer.begin(1)});
+    balancer.migrate(old_field.data.data(), old_field.halos, new_field.data.data(), new_field.halos);
+
+    for (int i = 0; i < new_field.size(0); ++i)
+        for (int j = 0; j < new_field.size(1); ++j)
+            for (int k = 0; k < NK; ++k)
+                EXPECT_EQ(new_field(i, j, k), global_value(new_field.begin[0] + i, new_field.begin[1] + j, k))
+                    << pid() << ": " << i << ", " << j << ", " << k;
+
+    // the halo exchange pattern is rebuilt with the new halo descriptors
+    halo_exchange_dynamic_ut<layout_map<0, 1, 2>, layout_map<0, 1, 2>, double, cpu> he(
+        boollist<3>(true, true, false), comm);
+    he.add_halo<0>(new_field.halos[0]);
+    he.add_halo<1>(new_field.halos[1]);
+    he.add_halo<2>(new_field.halos[2]);
+    he.setup(1);
+    he.pack(new_field.data.data());
+    he.exchange();
+    he.unpack(new_field.data.data());
+
+    for (int i = -H; i < new_field.size(0) + H; ++i)
+        for (int j = -H; j < new_field.size(1) + H; ++j)
+            for (int k = 0; k < NK; ++k)
+                EXPECT_EQ(new_field(i, j, k), global_value(new_field.begin[0] + i, new_field.begin[1] + j, k))
+                    << pid() << ": " << i << ", " << j << ", " << k;
+    MPI_Comm_free(&comm);
+}
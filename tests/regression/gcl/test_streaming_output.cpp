@@ -0,0 +1,89 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/gcl/streaming_output.hpp>
+
+#include <cstdio>
+#include <vector>
+
+#include <mpi.h>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/common/array.hpp>
+#include <gridtools/common/boollist.hpp>
+#include <gridtools/common/halo_descriptor.hpp>
+#include <gridtools/gcl/GCL.hpp>
+#include <gridtools/gcl/low_level/proc_grids_3D.hpp>
+
+using namespace gridtools;
+using namespace gcl;
+
+TEST(gcl, test_streaming_output) {
+    constexpr int N = 5;
+    constexpr int H = 2;
+    constexpr int steps = 3;
+
+    typedef MPI_3D_process_grid_t<3> grid_type;
+
+    array<int, 3> dims{0, 0, 0};
+    grid_type pgrid(boollist<3>(true, true, true), MPI_COMM_WORLD, dims);
+
+    int pi, pj, pk;
+    int PI, PJ, PK;
+    pgrid.coords(pi, pj, pk);
+    pgrid.dims(PI, PJ, PK);
+
+    array<halo_descriptor, 3> local = {halo_descriptor(H, H, H, N + H - 1, N + 2 * H),
+        halo_descriptor(H, H, H, N + H - 1, N + 2 * H),
+        halo_descriptor(H, H, H, N + H - 1, N + 2 * H)};
+    array<int, 3> global_begin = {pi * N, pj * N, pk * N};
+
+    streaming_output<int, grid_type> out(pgrid, local, global_begin, 2, "test_streaming_output");
+    EXPECT_EQ(out.global_sizes()[0], PI * N);
+    EXPECT_EQ(out.global_sizes()[1], PJ * N);
+    EXPECT_EQ(out.global_sizes()[2], PK * N);
+
+    auto global_index = [&](int i, int j, int k) {
+        return ((pi * N + i - H) * PJ * N + pj * N + j - H) * PK * N + pk * N + k - H;
+    };
+
+    std::vector<int> field((N + 2 * H) * (N + 2 * H) * (N + 2 * H));
+    for (int step = 0; step < steps; ++step) {
+        for (int i = 0; i < N + 2 * H; ++i)
+            for (int j = 0; j < N + 2 * H; ++j)
+                for (int k = 0; k < N + 2 * H; ++k)
+                    field[(i * (N + 2 * H) + j) * (N + 2 * H) + k] = step * 100000 + global_index(i, j, k);
+        out.write(field.data());
+        // the field can be reused right away
+        std::fill(field.begin(), field.end(), -1);
+    }
+    out.flush();
+    EXPECT_EQ(out.steps(), steps);
+
+    int nprocs;
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+    int num_aggregators = (nprocs + 1) / 2;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (pid() == 0) {
+        for (int step = 0; step < steps; ++step) {
+            std::vector<int> global;
+            for (int a = 0; a < num_aggregators; ++a) {
+                std::string name = "test_streaming_output." + std::to_string(step) + "." + std::to_string(a) + ".bin";
+                read_output_file(name, global);
+                std::remove(name.c_str());
+            }
+            ASSERT_EQ(global.size(), PI * N * PJ * N * PK * N);
+            for (size_t n = 0; n < global.size(); ++n)
+                EXPECT_EQ(global[n], step * 100000 + (int)n);
+        }
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+}
@@ -131,6 +131,41 @@ namespace {
                         &out] { run(get_spec(TypeParam()), TypeParam::backend(), grid, in, coeff, out); };
         comp();
         TypeParam::verify(repo.out, out);
-        TypeParam::benchmark("horizontal_diffusion", comp);
+        TypeParam::benchmark("horizontal_diffusion", comp, 3);
+    }
+
+    GT_REGRESSION_TEST(horizontal_diffusion_interleaved, test_environment<2>, stencil_backend_t) {
+        // the rows of the fields that are read by `out_function` alternate in memory
+        horizontal_diffusion_repository repo(TypeParam::d(0), TypeParam::d(1), TypeParam::d(2));
+        auto fields = TypeParam::make_interleaved_storages(repo.in, repo.coeff, [](int, int, int) { return 0; });
+        auto comp = [grid = TypeParam::make_grid(), &fields] {
+            run(get_spec(TypeParam()), TypeParam::backend(), grid, fields[0], fields[1], fields[2]);
+        };
+        comp();
+        TypeParam::verify(repo.out, fields[2]);
+        TypeParam::benchmark("horizontal_diffusion_interleaved", comp, 3);
+    }
+
+    GT_REGRESSION_TEST(horizontal_diffusion_inlined, test_environment<2>, stencil_backend_t) {
+        // the laplacian is recomputed in the flux stages instead of being stored
+        auto spec = [](auto in, auto coeff, auto out) {
+            GT_DECLARE_TMP(typename TypeParam::float_t, lap, flx, fly);
+            return execute_parallel()
+                .stage(lap_function(), lap, in)
+                .stage(flx_function(), flx, in, lap)
+                .stage(fly_function(), fly, in, lap)
+                .stage(out_function(), out, in, flx, fly, coeff)
+                .inlined(lap);
+        };
+        horizontal_diffusion_repository repo(TypeParam::d(0), TypeParam::d(1), TypeParam::d(2));
+        auto out = TypeParam::make_storage();
+        auto comp = [grid = TypeParam::make_grid(),
+                        coeff = TypeParam::make_const_storage(repo.coeff),
+                        in = TypeParam::make_const_storage(repo.in),
+                        &spec,
+                        &out] { run(spec, TypeParam::backend(), grid, in, coeff, out); };
+        comp();
+        TypeParam::verify(repo.out, out);
+        TypeParam::benchmark("horizontal_diffusion_inlined", comp, 3);
     }
 } // namespace
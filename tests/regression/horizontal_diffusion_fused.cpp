@@ -97,6 +97,6 @@ namespace {
 
         comp();
         TypeParam::verify(repo.out, out);
-        TypeParam::benchmark("horizontal_diffusion_fused", comp);
+        TypeParam::benchmark("horizontal_diffusion_fused", comp, 3);
     }
 } // namespace
@@ -58,6 +58,6 @@ namespace {
                     return false;
             return true;
         });
-        TypeParam::benchmark("stencil_manual_fold", comp);
+        TypeParam::benchmark("stencil_manual_fold", comp, 8);
     }
 } // namespace
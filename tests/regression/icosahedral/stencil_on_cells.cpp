@@ -49,6 +49,38 @@ namespace {
         };
         comp();
         TypeParam::verify(ref, out);
-        TypeParam::benchmark("stencil_on_cells", comp);
+        TypeParam::benchmark("stencil_on_cells", comp, 4);
+    }
+
+    struct test_on_cells_mixed_precision_functor {
+        using in = in_accessor<0, cells, extent<-1, 1, -1, 1>>;
+        using out = inout_accessor<1, cells>;
+        using param_list = make_param_list<in, out>;
+        using location = cells;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            double res = 0;
+            eval.for_neighbors([&](double in) { res += in; }, in());
+            eval(out()) = res;
+        }
+    };
+
+    GT_REGRESSION_TEST(stencil_on_cells_mixed_precision, icosahedral_test_environment<1>, stencil_backend_t) {
+        auto in = [](int_t i, int_t j, int_t k, int_t c) { return i + j + k + c; };
+        auto ref = [&](int_t i, int_t j, int_t k, int_t c) {
+            double res = {};
+            for (auto &&item : neighbours_of<cells, cells>(i, j, k, c))
+                res += item.call(in);
+            return res;
+        };
+        auto builder = TypeParam::template icosahedral_builder<float>(cells()).template compute_type<double>();
+        auto out = builder.build();
+        run_single_stage(test_on_cells_mixed_precision_functor(),
+            stencil_backend_t(),
+            TypeParam::make_grid(),
+            builder.initializer(in).build(),
+            out);
+        TypeParam::verify(ref, out);
     }
 } // namespace
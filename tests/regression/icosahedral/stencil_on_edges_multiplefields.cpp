@@ -52,6 +52,6 @@ namespace {
                         &out] { run_single_stage(test_on_edges_functor(), stencil_backend_t(), grid, in1, in2, out); };
         comp();
         TypeParam::verify(ref, out);
-        TypeParam::benchmark("stencil_on_edges_multiplefields", comp);
+        TypeParam::benchmark("stencil_on_edges_multiplefields", comp, 9);
     }
 } // namespace
@@ -49,6 +49,6 @@ namespace {
         };
         comp();
         TypeParam::verify(ref, out);
-        TypeParam::benchmark("stencil_on_neighcell_of_edges", comp);
+        TypeParam::benchmark("stencil_on_neighcell_of_edges", comp, 5);
     }
 } // namespace
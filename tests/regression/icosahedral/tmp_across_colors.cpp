@@ -0,0 +1,116 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/stencil/icosahedral.hpp>
+
+#include <stencil_select.hpp>
+#include <test_environment.hpp>
+
+#include "neighbours_of.hpp"
+
+namespace {
+    using namespace gridtools;
+    using namespace stencil;
+    using namespace icosahedral;
+
+    // every color of the edges is computed differently
+    struct on_edges_color_functor {
+        using in = in_accessor<0, edges>;
+        using out = inout_accessor<1, edges>;
+        using param_list = make_param_list<in, out>;
+        using location = edges;
+
+        template <class Eval>
+        GT_FUNCTION static void apply(Eval &&eval) {
+            eval(out()) = (Eval::color + 1) * eval(in());
+        }
+    };
+
+    // reads the edges of all three colors
+    struct edges_to_cells_functor {
+        using in = in_accessor<0, edges, extent<0, 1, 0, 1>>;
+        using out = inout_accessor<1, cells>;
+        using param_list = make_param_list<in, out>;
+        using location = cells;
+
+        template <class Eval>
+        GT_FUNCTION static void apply(Eval &&eval) {
+            auto &&res = eval(out());
+            res = 0;
+            eval.for_neighbors([&](auto in) { res += in; }, in());
+        }
+    };
+
+    // the neighbours of a cell have the other color
+    struct cells_to_cells_functor {
+        using in = in_accessor<0, cells, extent<-1, 1, -1, 1>>;
+        using out = inout_accessor<1, cells>;
+        using param_list = make_param_list<in, out>;
+        using location = cells;
+
+        template <class Eval>
+        GT_FUNCTION static void apply(Eval &&eval) {
+            auto &&res = eval(out());
+            res = 0;
+            eval.for_neighbors([&](auto in) { res += in; }, in());
+        }
+    };
+
+    template <class Env>
+    auto make_ref() {
+        using float_t = typename Env::float_t;
+        auto in = [](int_t i, int_t j, int_t k, int_t c) { return i + j + k + c; };
+        auto edges_tmp = [=](int_t i, int_t j, int_t k, int_t c) { return (c + 1) * float_t(in(i, j, k, c)); };
+        auto cells_tmp = [=](int_t i, int_t j, int_t k, int_t c) {
+            float_t res{};
+            for (auto &&item : neighbours_of<cells, edges>(i, j, k, c))
+                res += item.call(edges_tmp);
+            return res;
+        };
+        return [=](int_t i, int_t j, int_t k, int_t c) {
+            float_t res{};
+            for (auto &&item : neighbours_of<cells, cells>(i, j, k, c))
+                res += item.call(cells_tmp);
+            return res;
+        };
+    }
+
+    GT_REGRESSION_TEST(tmp_across_colors, icosahedral_test_environment<2>, stencil_backend_t) {
+        using float_t = typename TypeParam::float_t;
+        auto in = [](int_t i, int_t j, int_t k, int_t c) { return i + j + k + c; };
+        const auto spec = [](auto in, auto out) {
+            GT_DECLARE_ICO_TMP(float_t, edges, edges_tmp);
+            GT_DECLARE_ICO_TMP(float_t, cells, cells_tmp);
+            return execute_parallel()
+                .stage(on_edges_color_functor(), in, edges_tmp)
+                .stage(edges_to_cells_functor(), edges_tmp, cells_tmp)
+                .stage(cells_to_cells_functor(), cells_tmp, out);
+        };
+        auto out = TypeParam::icosahedral_make_storage(cells());
+        run(spec, stencil_backend_t(), TypeParam::make_grid(), TypeParam::icosahedral_make_storage(edges(), in), out);
+        TypeParam::verify(make_ref<TypeParam>(), out);
+    }
+
+    GT_REGRESSION_TEST(tmp_across_colors_forward, icosahedral_test_environment<2>, stencil_backend_t) {
+        using float_t = typename TypeParam::float_t;
+        auto in = [](int_t i, int_t j, int_t k, int_t c) { return i + j + k + c; };
+        const auto spec = [](auto in, auto out) {
+            GT_DECLARE_ICO_TMP(float_t, edges, edges_tmp);
+            GT_DECLARE_ICO_TMP(float_t, cells, cells_tmp);
+            return execute_forward()
+                .stage(on_edges_color_functor(), in, edges_tmp)
+                .stage(edges_to_cells_functor(), edges_tmp, cells_tmp)
+                .stage(cells_to_cells_functor(), cells_tmp, out);
+        };
+        auto out = TypeParam::icosahedral_make_storage(cells());
+        run(spec, stencil_backend_t(), TypeParam::make_grid(), TypeParam::icosahedral_make_storage(edges(), in), out);
+        TypeParam::verify(make_ref<TypeParam>(), out);
+    }
+} // namespace
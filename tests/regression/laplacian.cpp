@@ -34,7 +34,11 @@ namespace {
             return 4 * in(i, j, k) - (in(i + 1, j, k) + in(i, j + 1, k) + in(i - 1, j, k) + in(i, j - 1, k));
         };
         auto out = TypeParam::make_storage();
-        run_single_stage(lap(), stencil_backend_t(), TypeParam::make_grid(), out, TypeParam::make_storage(in));
+        auto comp = [&out, grid = TypeParam::make_grid(), in = TypeParam::make_const_storage(in)] {
+            run_single_stage(lap(), stencil_backend_t(), grid, out, in);
+        };
+        comp();
         TypeParam::verify(ref, out);
+        TypeParam::benchmark("laplacian", comp, 2);
     }
 } // namespace
\ No newline at end of file
@@ -36,5 +36,5 @@ GT_REGRESSION_TEST(layout_transformation, test_environment<>, storage_traits_t)
     };
     testee();
     verify_result(src, dst);
-    TypeParam::benchmark("layout_transformation", testee);
+    TypeParam::benchmark("layout_transformation", testee, 2);
 }
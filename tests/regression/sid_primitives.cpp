@@ -0,0 +1,68 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gtest/gtest.h>
+
+#include <gridtools/common/integral_constant.hpp>
+#include <gridtools/common/tuple_util.hpp>
+#include <gridtools/sid/composite.hpp>
+#include <gridtools/sid/concept.hpp>
+#include <gridtools/sid/loop.hpp>
+#include <gridtools/storage/sid.hpp>
+
+#include <storage_select.hpp>
+#include <test_environment.hpp>
+
+// The overhead of the SID primitives in isolation: the loop nest and the shifts of a composite.
+namespace {
+    using namespace gridtools;
+
+    using i_t = integral_constant<int, 0>;
+    using j_t = integral_constant<int, 1>;
+    using k_t = integral_constant<int, 2>;
+
+    struct in_tag;
+    struct out_tag;
+
+    template <class Sid, class Body>
+    void loop_nest(Sid &&sid, Body body) {
+        auto &&lengths = sid->lengths();
+        auto ptr = sid::get_origin(sid)();
+        auto &&strides = sid::get_strides(sid);
+        sid::make_loop<i_t>(lengths[0])(sid::make_loop<j_t>(lengths[1])(sid::make_loop<k_t>(lengths[2])(body)))(
+            ptr, strides);
+    }
+
+    GT_REGRESSION_TEST(sid_loop, test_environment<>, storage_traits_t) {
+        auto field = TypeParam::make_storage(0);
+        auto testee = [&] {
+            loop_nest(field, [](auto &ptr, auto const &) { *ptr += 1; });
+        };
+        testee();
+        TypeParam::verify(1, field);
+        TypeParam::benchmark("sid_loop", testee, 2);
+    }
+
+    GT_REGRESSION_TEST(sid_composite, test_environment<>, storage_traits_t) {
+        auto in = TypeParam::make_storage([](int i, int j, int k) { return i + j + k; });
+        auto out = TypeParam::make_storage(0);
+        auto testee = [&] {
+            auto composite = tuple_util::make<sid::composite::keys<in_tag, out_tag>::values>(in, out);
+            auto &&lengths = out->lengths();
+            auto ptr = sid::get_origin(composite)();
+            auto &&strides = sid::get_strides(composite);
+            sid::make_loop<i_t>(lengths[0])(sid::make_loop<j_t>(lengths[1])(sid::make_loop<k_t>(lengths[2])(
+                [](auto &ptr, auto const &) { *at_key<out_tag>(ptr) = *at_key<in_tag>(ptr); })))(ptr, strides);
+        };
+        testee();
+        TypeParam::verify([](int i, int j, int k) { return i + j + k; }, out);
+        TypeParam::benchmark("sid_composite", testee, 2);
+    }
+} // namespace
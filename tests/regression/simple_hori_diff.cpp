@@ -81,6 +81,6 @@ namespace {
         };
         comp();
         TypeParam::verify(repo.out_simple, out);
-        TypeParam::benchmark("simple_hori_diff", comp);
+        TypeParam::benchmark("simple_hori_diff", comp, 3);
     }
 } // namespace
@@ -127,6 +127,20 @@ namespace {
 
     using env_t = vertical_test_environment<3, axis_t>;
 
+    template <class Float>
+    auto vertical_advection_spec() {
+        return [](auto utens_stage, auto u_stage, auto wcon, auto u_pos, auto utens, auto dtr_stage) {
+            GT_DECLARE_TMP(Float, ccol, dcol, data_col);
+            return multi_pass(
+                execute_forward()
+                    .k_cached(cache_io_policy::flush(), ccol, dcol)
+                    .k_cached(cache_io_policy::fill(), u_stage)
+                    .stage(u_forward_function(), utens_stage, wcon, u_stage, u_pos, utens, dtr_stage, ccol, dcol),
+                execute_backward().k_cached(data_col).stage(
+                    u_backward_function(), utens_stage, u_pos, dtr_stage, ccol, dcol, data_col));
+        };
+    }
+
     GT_REGRESSION_TEST(vertical_advection_dycore, env_t, modified_backend_t) {
         vertical_advection_repository repo{TypeParam::d(0), TypeParam::d(1), TypeParam::d(2)};
         auto utens_stage = TypeParam::make_storage(repo.utens_stage_in);
@@ -137,20 +151,41 @@ namespace {
                         u_pos = TypeParam::make_storage(repo.u_pos),
                         utens = TypeParam::make_storage(repo.utens),
                         dtr_stage = make_global_parameter(typename TypeParam::float_t(repo.dtr_stage))] {
-            const auto spec = [](auto utens_stage, auto u_stage, auto wcon, auto u_pos, auto utens, auto dtr_stage) {
-                GT_DECLARE_TMP(typename TypeParam::float_t, ccol, dcol, data_col);
-                return multi_pass(
-                    execute_forward()
-                        .k_cached(cache_io_policy::flush(), ccol, dcol)
-                        .k_cached(cache_io_policy::fill(), u_stage)
-                        .stage(u_forward_function(), utens_stage, wcon, u_stage, u_pos, utens, dtr_stage, ccol, dcol),
-                    execute_backward().k_cached(data_col).stage(
-                        u_backward_function(), utens_stage, u_pos, dtr_stage, ccol, dcol, data_col));
-            };
-            run(spec, modified_backend_t(), grid, utens_stage, u_stage, wcon, u_pos, utens, dtr_stage);
+            run(vertical_advection_spec<typename TypeParam::float_t>(),
+                modified_backend_t(),
+                grid,
+                utens_stage,
+                u_stage,
+                wcon,
+                u_pos,
+                utens,
+                dtr_stage);
         };
         comp();
         TypeParam::verify(repo.utens_stage_out, utens_stage);
-        TypeParam::benchmark("vertical_advection_dycore", comp);
+        TypeParam::benchmark("vertical_advection_dycore", comp, 6);
+    }
+
+    GT_REGRESSION_TEST(vertical_advection_dycore_interleaved, env_t, modified_backend_t) {
+        // the rows of the fields that are read at the same point alternate in memory
+        vertical_advection_repository repo{TypeParam::d(0), TypeParam::d(1), TypeParam::d(2)};
+        auto fields = TypeParam::make_interleaved_storages(
+            repo.utens_stage_in, repo.u_stage, repo.wcon, repo.u_pos, repo.utens);
+        auto comp = [&,
+                        grid = TypeParam::make_grid(),
+                        dtr_stage = make_global_parameter(typename TypeParam::float_t(repo.dtr_stage))] {
+            run(vertical_advection_spec<typename TypeParam::float_t>(),
+                modified_backend_t(),
+                grid,
+                fields[0],
+                fields[1],
+                fields[2],
+                fields[3],
+                fields[4],
+                dtr_stage);
+        };
+        comp();
+        TypeParam::verify(repo.utens_stage_out, fields[0]);
+        TypeParam::benchmark("vertical_advection_dycore_interleaved", comp, 6);
     }
 } // namespace
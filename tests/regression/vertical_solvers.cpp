@@ -0,0 +1,146 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil/cartesian.hpp>
+
+#include <stencil_select.hpp>
+#include <test_environment.hpp>
+
+/*
+  The systems are diagonally dominant and the right hand sides are computed from a known solution.
+ */
+
+namespace {
+    using namespace gridtools;
+    using namespace stencil;
+    using namespace cartesian;
+
+    using axis_t = axis<1, axis_config::offset_limit<3>>;
+    using full_t = axis_t::full_interval;
+
+    using env_t = vertical_test_environment<0, axis_t>;
+
+    double expected(int i, int j, int k) { return 1 + std::sin(.3 * i + .2 * j + .1 * k); }
+    double lower(int i, int, int k) { return -1 + .1 * ((i + k) % 3); }
+    double upper(int, int j, int k) { return -1 + .1 * ((j + 2 * k) % 5); }
+    double center(int i, int j, int k) { return 5 + .1 * ((i + j + k) % 4); }
+
+    GT_REGRESSION_TEST(vertical_solvers_tridiagonal, env_t, stencil_backend_t) {
+        int k_size = TypeParam::k_size();
+        auto rhs = [k_size](int i, int j, int k) {
+            auto res = center(i, j, k) * expected(i, j, k);
+            if (k > 0)
+                res += lower(i, j, k) * expected(i, j, k - 1);
+            if (k < k_size - 1)
+                res += upper(i, j, k) * expected(i, j, k + 1);
+            return res;
+        };
+        auto out = TypeParam::make_storage();
+        auto comp = [&,
+                        grid = TypeParam::make_grid(),
+                        inf = TypeParam::make_const_storage(lower),
+                        diag = TypeParam::make_const_storage(center),
+                        sup = TypeParam::make_const_storage(upper),
+                        rhs = TypeParam::make_const_storage(rhs)] {
+            run(
+                [](auto inf, auto diag, auto sup, auto rhs, auto out) {
+                    return solve_tridiagonal<typename TypeParam::float_t, full_t>(inf, diag, sup, rhs, out);
+                },
+                stencil_backend_t(),
+                grid,
+                inf,
+                diag,
+                sup,
+                rhs,
+                out);
+        };
+        comp();
+        TypeParam::verify(expected, out);
+        TypeParam::benchmark("vertical_solvers_tridiagonal", comp, 5);
+    }
+
+    GT_REGRESSION_TEST(vertical_solvers_periodic_tridiagonal, env_t, stencil_backend_t) {
+        int k_size = TypeParam::k_size();
+        auto rhs = [k_size](int i, int j, int k) {
+            return lower(i, j, k) * expected(i, j, (k + k_size - 1) % k_size) + center(i, j, k) * expected(i, j, k) +
+                   upper(i, j, k) * expected(i, j, (k + 1) % k_size);
+        };
+        auto out = TypeParam::make_storage();
+        auto comp = [&,
+                        grid = TypeParam::make_grid(),
+                        inf = TypeParam::make_const_storage(lower),
+                        diag = TypeParam::make_const_storage(center),
+                        sup = TypeParam::make_const_storage(upper),
+                        rhs = TypeParam::make_const_storage(rhs)] {
+            run(
+                [](auto inf, auto diag, auto sup, auto rhs, auto out) {
+                    return solve_periodic_tridiagonal<typename TypeParam::float_t, full_t>(inf, diag, sup, rhs, out);
+                },
+                stencil_backend_t(),
+                grid,
+                inf,
+                diag,
+                sup,
+                rhs,
+                out);
+        };
+        comp();
+        TypeParam::verify(expected, out);
+        TypeParam::benchmark("vertical_solvers_periodic_tridiagonal", comp, 5);
+    }
+
+    GT_REGRESSION_TEST(vertical_solvers_pentadiagonal, env_t, stencil_backend_t) {
+        int k_size = TypeParam::k_size();
+        auto lower2 = [](int i, int j, int k) { return .5 * lower(j, i, k); };
+        auto upper2 = [](int i, int j, int k) { return .5 * upper(j, i, k); };
+        auto rhs = [=](int i, int j, int k) {
+            auto res = center(i, j, k) * expected(i, j, k);
+            if (k > 1)
+                res += lower2(i, j, k) * expected(i, j, k - 2);
+            if (k > 0)
+                res += lower(i, j, k) * expected(i, j, k - 1);
+            if (k < k_size - 1)
+                res += upper(i, j, k) * expected(i, j, k + 1);
+            if (k < k_size - 2)
+                res += upper2(i, j, k) * expected(i, j, k + 2);
+            return res;
+        };
+        auto out = TypeParam::make_storage();
+        auto comp = [&,
+                        grid = TypeParam::make_grid(),
+                        inf2 = TypeParam::make_const_storage(lower2),
+                        inf = TypeParam::make_const_storage(lower),
+                        diag = TypeParam::make_const_storage(center),
+                        sup = TypeParam::make_const_storage(upper),
+                        sup2 = TypeParam::make_const_storage(upper2),
+                        rhs = TypeParam::make_const_storage(rhs)] {
+            run(
+                [](auto inf2, auto inf, auto diag, auto sup, auto sup2, auto rhs, auto out) {
+                    return solve_pentadiagonal<typename TypeParam::float_t, full_t>(
+                        inf2, inf, diag, sup, sup2, rhs, out);
+                },
+                stencil_backend_t(),
+                grid,
+                inf2,
+                inf,
+                diag,
+                sup,
+                sup2,
+                rhs,
+                out);
+        };
+        comp();
+        TypeParam::verify(expected, out);
+        TypeParam::benchmark("vertical_solvers_pentadiagonal", comp, 7);
+    }
+} // namespace
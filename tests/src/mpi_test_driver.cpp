@@ -46,7 +46,8 @@ int main(int argc, char **argv) {
     GT_CUDA_CHECK(cudaSetDevice(get_local_rank() % dev_device_count()));
 #endif
 
-    gridtools::gcl::init(argc, argv);
+    // the halo exchange tests use the progress thread
+    gridtools::gcl::init(argc, argv, MPI_THREAD_MULTIPLE);
 
     // initialize google test environment
     testing::InitGoogleTest(&argc, argv);
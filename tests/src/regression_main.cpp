@@ -11,12 +11,14 @@
 #include <timer_select.hpp>
 
 #include <cassert>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <map>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -119,12 +121,43 @@ namespace {
         separator(std::string val) : m_val(std::move(val)), m_is_first(true) {}
     };
 
+    // quotes `src` as a JSON string
+    std::string json_string(std::string const &src) {
+        std::string res = "\"";
+        for (char c : src) {
+            switch (c) {
+            case '"':
+                res += "\\\"";
+                break;
+            case '\\':
+                res += "\\\\";
+                break;
+            case '\n':
+                res += "\\n";
+                break;
+            case '\t':
+                res += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[7];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    res += buf;
+                } else
+                    res += c;
+            }
+        }
+        return res + "\"";
+    }
+
     class perf_times {
         using key_t = std::tuple<std::string, std::string, std::string>;
         using value_t = std::vector<double>;
         using map_t = std::map<key_t, value_t>;
 
         map_t m_map;
+        std::map<key_t, std::string> m_counters;
+        std::map<key_t, std::pair<size_t, size_t>> m_sizes;
 
         friend std::ostream &operator<<(std::ostream &strm, perf_times const &obj) {
             strm << "{\n";
@@ -134,9 +167,9 @@ namespace {
                 if (outputs)
                     strm << ",";
                 strm << "\n    {\n";
-                strm << "      \"name\" : \"" << std::get<0>(item.first) << "\",\n";
-                strm << "      \"backend\" : \"" << std::get<1>(item.first) << "\",\n";
-                strm << "      \"float_type\" : \"" << std::get<2>(item.first) << "\",\n";
+                strm << "      \"name\" : " << json_string(std::get<0>(item.first)) << ",\n";
+                strm << "      \"backend\" : " << json_string(std::get<1>(item.first)) << ",\n";
+                strm << "      \"float_type\" : " << json_string(std::get<2>(item.first)) << ",\n";
                 strm << "      \"series\" : [";
                 int series = 0;
                 for (auto val : item.second) {
@@ -145,8 +178,17 @@ namespace {
                     strm << val;
                     ++series;
                 }
-                strm << "]\n";
-                strm << "    }";
+                strm << "]";
+                auto sizes = obj.m_sizes.find(item.first);
+                if (sizes != obj.m_sizes.end()) {
+                    strm << ",\n      \"points\" : " << sizes->second.first;
+                    if (sizes->second.second)
+                        strm << ",\n      \"bytes\" : " << sizes->second.second;
+                }
+                auto counters = obj.m_counters.find(item.first);
+                if (counters != obj.m_counters.end())
+                    strm << ",\n      \"counters\" : " << json_string(counters->second);
+                strm << "\n    }";
                 ++outputs;
             }
             if (outputs)
@@ -160,8 +202,32 @@ namespace {
         void add(std::string const &name, std::string const &backend, std::string const &float_type, double time) {
             m_map[key_t(name, backend, float_type)].push_back(time);
         }
+
+        void add_counters(
+            std::string const &name, std::string const &backend, std::string const &float_type, std::string counters) {
+            m_counters[key_t(name, backend, float_type)] = std::move(counters);
+        }
+
+        void add_sizes(std::string const &name,
+            std::string const &backend,
+            std::string const &float_type,
+            size_t points,
+            size_t bytes) {
+            m_sizes[key_t(name, backend, float_type)] = {points, bytes};
+        }
     };
 
+    void flush_caches() {
+        static std::size_t n = 1024 * 1024 * 21 / 2;
+        static std::vector<double> a_(n), b_(n), c_(n);
+        double *a = a_.data();
+        double *b = b_.data();
+        double *c = c_.data();
+#pragma omp parallel for
+        for (std::size_t i = 0; i < n; i++)
+            a[i] = b[i] * c[i];
+    }
+
     auto &times() {
         static perf_times res;
         return res;
@@ -174,22 +240,27 @@ namespace gridtools {
             times().add(name, backend, float_type, time);
         }
 
+        void add_counters(
+            std::string const &name, std::string const &backend, std::string const &float_type, std::string counters) {
+            times().add_counters(name, backend, float_type, std::move(counters));
+        }
+
+        void add_sizes(std::string const &name,
+            std::string const &backend,
+            std::string const &float_type,
+            size_t points,
+            size_t bytes) {
+            times().add_sizes(name, backend, float_type, points, bytes);
+        }
+
         int cmdline_params::d(size_t i) { return s_state.m_d[i]; }
         size_t cmdline_params::steps() { return s_state.m_steps; }
         bool cmdline_params::needs_verification() { return s_state.m_needs_verification; }
         int &cmdline_params::argc() { return s_state.m_argc; }
         char **cmdline_params::argv() { return s_state.m_argv; }
 
-        void flush_cache(timer_omp const &) {
-            static std::size_t n = 1024 * 1024 * 21 / 2;
-            static std::vector<double> a_(n), b_(n), c_(n);
-            double *a = a_.data();
-            double *b = b_.data();
-            double *c = c_.data();
-#pragma omp parallel for
-            for (std::size_t i = 0; i < n; i++)
-                a[i] = b[i] * c[i];
-        }
+        void flush_cache(timer_omp const &) { flush_caches(); }
+        void flush_cache(timer_perf const &) { flush_caches(); }
     } // namespace test_environment_impl_
 } // namespace gridtools
 
@@ -161,3 +161,31 @@ TEST_F(distributed_boundaries_test, exchange) {
     expect_b([&](int i, int j, int k) { return from_abroad(i, j) ? c_init(i, j, k) : b_init(i, j, k); });
     expect_d([&](int i, int j, int k) { return from_abroad(i, j) ? triplet{} : d_init(i, j, k); });
 }
+
+TEST_F(distributed_boundaries_test, skip_unmodified) {
+    testee.skip_unmodified();
+    testee.exchange(bind_bc(value_boundary<triplet>(triplet{42, 42, 42}), a), d);
+    EXPECT_EQ(testee.get_count_skipped(), 0);
+    testee.exchange(bind_bc(value_boundary<triplet>(triplet{42, 42, 42}), a), d);
+    EXPECT_EQ(testee.get_count_skipped(), 2);
+    testee.exchange(d);
+    EXPECT_EQ(testee.get_count_skipped(), 3);
+    expect_a([&](int i, int j, int k) { return from_abroad(i, j) ? triplet{42, 42, 42} : a_init(i, j, k); });
+    expect_d([&](int i, int j, int k) { return from_abroad(i, j) ? triplet{} : d_init(i, j, k); });
+}
+
+TEST_F(distributed_boundaries_test, skip_unmodified_is_collective) {
+    testee.skip_unmodified();
+    testee.exchange(b, d);
+    EXPECT_EQ(testee.get_count_skipped(), 0);
+    if (gcl::pid() == 0) {
+        auto view = d->host_view();
+        for (int i = halo_size; i < d1 - halo_size; ++i)
+            for (int j = halo_size; j < d2 - halo_size; ++j)
+                for (int k = 0; k < d3; ++k)
+                    view(i, j, k) = b_init(i, j, k);
+    }
+    testee.exchange(b, d);
+    EXPECT_EQ(testee.get_count_skipped(), 1);
+    expect_b([&](int i, int j, int k) { return from_abroad(i, j) ? triplet{} : b_init(i, j, k); });
+}
@@ -0,0 +1,185 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/boundaries/fused_boundaries.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/boundaries/bound_bc.hpp>
+#include <gridtools/boundaries/boundary.hpp>
+#include <gridtools/boundaries/copy.hpp>
+#include <gridtools/boundaries/value.hpp>
+#include <gridtools/common/halo_descriptor.hpp>
+#include <gridtools/gcl/low_level/arch.hpp>
+#include <gridtools/stencil/cartesian.hpp>
+#include <gridtools/stencil/cpu_kfirst.hpp>
+#include <gridtools/stencil/naive.hpp>
+#include <gridtools/storage/builder.hpp>
+#include <gridtools/storage/cpu_kfirst.hpp>
+#include <gridtools/storage/sid.hpp>
+
+namespace {
+    using namespace gridtools;
+    using namespace boundaries;
+    using namespace stencil;
+    using namespace cartesian;
+
+    constexpr int halo = 2;
+    constexpr int d1 = 19;
+    constexpr int d2 = 13;
+    constexpr int d3 = 5;
+
+    struct scale_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1>;
+        using param_list = make_param_list<out, in>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(out()) = 2 * eval(in());
+        }
+    };
+
+    struct lap_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+        using param_list = make_param_list<out, in>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(out()) = 4 * eval(in()) - (eval(in(1, 0)) + eval(in(0, 1)) + eval(in(-1, 0)) + eval(in(0, -1)));
+        }
+    };
+
+    // copies the closest core point of the field to the halo point
+    struct clamp_boundary {
+        int_t begin0, end0, begin1, end1;
+
+        template <typename Direction, typename DataField>
+        void operator()(Direction, DataField &field, uint_t i, uint_t j, uint_t k) const {
+            field(i, j, k) = field(std::min(std::max<int_t>(i, begin0), end0),
+                std::min(std::max<int_t>(j, begin1), end1),
+                k);
+        }
+    };
+
+    const auto builder = storage::builder<storage::cpu_kfirst>.type<double>().dimensions(
+        d1 + 2 * halo, d2 + 2 * halo, d3);
+
+    array<halo_descriptor, 3> make_halos() {
+        return {{{halo, halo, halo, d1 + halo - 1, d1 + 2 * halo},
+            {halo, halo, halo, d2 + halo - 1, d2 + 2 * halo},
+            {0, 0, 0, d3 - 1, d3}}};
+    }
+
+    auto spec = [](auto out, auto in) { return execute_parallel().stage(scale_function(), out, in); };
+
+    double initial(int i, int j, int k) { return i * 100 + j * 10 + k; }
+
+    template <class Backend>
+    void check(Backend backend_for) {
+        auto halos = make_halos();
+        auto grid = make_grid(halos[0], halos[1], d3);
+        clamp_boundary clamp = {halo, d1 + halo - 1, halo, d2 + halo - 1};
+
+        auto in = builder.initializer(initial)();
+        auto out = builder.value(-1)();
+        auto clamped = builder.value(-1)();
+        auto ref_in = builder.initializer(initial)();
+        auto ref_out = builder.value(-1)();
+        auto ref_clamped = builder.value(-1)();
+
+        auto two_stages = [](auto out, auto clamped, auto in) {
+            return execute_parallel()
+                .stage(scale_function(), out, in)
+                .stage(scale_function(), clamped, out);
+        };
+
+        run(two_stages, naive(), grid, ref_out, ref_clamped, ref_in);
+        make_boundary<gcl::cpu>(halos, copy_boundary()).apply(ref_out, ref_in);
+        make_boundary<gcl::cpu>(halos, clamp).apply(ref_clamped);
+        make_boundary<gcl::cpu>(halos, value_boundary<double>(42)).apply(ref_in);
+
+        auto backend = fuse_boundaries<gcl::cpu>(backend_for,
+            halos,
+            bind_bc(copy_boundary(), out, in),
+            bind_bc(clamp, clamped),
+            bind_bc(value_boundary<double>(42), in));
+        run(two_stages, backend, grid, out, clamped, in);
+
+        auto out_v = out->const_host_view();
+        auto clamped_v = clamped->const_host_view();
+        auto in_v = in->const_host_view();
+        auto ref_out_v = ref_out->const_host_view();
+        auto ref_clamped_v = ref_clamped->const_host_view();
+        auto ref_in_v = ref_in->const_host_view();
+        for (int i = 0; i < d1 + 2 * halo; ++i)
+            for (int j = 0; j < d2 + 2 * halo; ++j)
+                for (int k = 0; k < d3; ++k) {
+                    EXPECT_EQ(out_v(i, j, k), ref_out_v(i, j, k)) << i << ", " << j << ", " << k;
+                    EXPECT_EQ(clamped_v(i, j, k), ref_clamped_v(i, j, k)) << i << ", " << j << ", " << k;
+                    EXPECT_EQ(in_v(i, j, k), ref_in_v(i, j, k)) << i << ", " << j << ", " << k;
+                }
+    }
+
+    TEST(fused_boundaries, cpu_kfirst) { check(cpu_kfirst<>()); }
+
+    TEST(fused_boundaries, small_blocks) {
+        check(cpu_kfirst<integral_constant<int_t, 3>, integral_constant<int_t, 4>>());
+    }
+
+    TEST(fused_boundaries, naive) { check(naive()); }
+
+    // the boundary of `in` is applied after the computation: the first stage is computed beyond every block and
+    // reads the halos of `in` next to the neighbouring blocks
+    TEST(fused_boundaries, read_at_offset) {
+        auto halos = make_halos();
+        auto grid = make_grid(halos[0], halos[1], d3);
+        auto lap = [](auto out, auto in) {
+            GT_DECLARE_TMP(double, tmp);
+            return execute_parallel().stage(lap_function(), tmp, in).stage(lap_function(), out, tmp);
+        };
+
+        auto in = builder.initializer(initial)();
+        auto out = builder.value(-1)();
+        auto ref_in = builder.initializer(initial)();
+        auto ref_out = builder.value(-1)();
+
+        run(lap, naive(), grid, ref_out, ref_in);
+        make_boundary<gcl::cpu>(halos, value_boundary<double>(42)).apply(ref_out, ref_in);
+
+        auto backend = fuse_boundaries<gcl::cpu>(cpu_kfirst<integral_constant<int_t, 3>, integral_constant<int_t, 4>>(),
+            halos,
+            bind_bc(value_boundary<double>(42), out, in));
+        run(lap, backend, grid, out, in);
+
+        auto out_v = out->const_host_view();
+        auto in_v = in->const_host_view();
+        auto ref_out_v = ref_out->const_host_view();
+        auto ref_in_v = ref_in->const_host_view();
+        for (int i = 0; i < d1 + 2 * halo; ++i)
+            for (int j = 0; j < d2 + 2 * halo; ++j)
+                for (int k = 0; k < d3; ++k) {
+                    EXPECT_EQ(out_v(i, j, k), ref_out_v(i, j, k)) << i << ", " << j << ", " << k;
+                    EXPECT_EQ(in_v(i, j, k), ref_in_v(i, j, k)) << i << ", " << j << ", " << k;
+                }
+    }
+
+    TEST(fused_boundaries, grid_should_cover_the_core) {
+        auto halos = make_halos();
+        auto in = builder.initializer(initial)();
+        auto out = builder.value(-1)();
+        auto backend = fuse_boundaries<gcl::cpu>(cpu_kfirst<>(), halos, bind_bc(copy_boundary(), out, in));
+        auto grid = make_grid(d1 + 2 * halo, d2 + 2 * halo, d3);
+        EXPECT_THROW(run(spec, backend, grid, out, in), std::runtime_error);
+    }
+} // namespace
@@ -0,0 +1,58 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/common/timer/timer.hpp>
+#include <gridtools/common/timer/timer_perf.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace gridtools {
+    namespace {
+        double work(std::vector<double> &data) {
+            for (size_t i = 1; i < data.size(); ++i)
+                data[i] += .5 * data[i - 1];
+            return data.back();
+        }
+
+        TEST(timer_perf, counters) {
+            std::vector<double> data(1 << 16, 1);
+            timer_perf testee;
+            testee.start_impl();
+            volatile double sink = work(data);
+            (void)sink;
+            EXPECT_GE(testee.pause_impl(), 0);
+            // the counters may be unavailable in containers, but they are never bogus
+            auto cycles = testee.value(timer_perf_impl_::cycles);
+            auto instructions = testee.value(timer_perf_impl_::instructions);
+            EXPECT_TRUE(cycles == -1 || cycles > 0);
+            EXPECT_TRUE(instructions == -1 || instructions > (long long)data.size());
+        }
+
+        TEST(timer_perf, to_string) {
+            timer<timer_perf> testee("name");
+            testee.start();
+            testee.pause();
+            auto str = testee.to_string();
+            EXPECT_NE(str.find("name"), std::string::npos);
+            EXPECT_NE(str.find("IPC"), std::string::npos);
+            EXPECT_NE(str.find("LLC traffic [GB/s]"), std::string::npos);
+        }
+
+        TEST(timer_perf, reset) {
+            timer<timer_perf> testee;
+            testee.start();
+            testee.pause();
+            testee.reset();
+            EXPECT_EQ(testee.count(), 0);
+            EXPECT_NE(testee.to_string().find("cycles n/a"), std::string::npos);
+        }
+    } // namespace
+} // namespace gridtools
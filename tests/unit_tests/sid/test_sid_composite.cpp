@@ -16,6 +16,7 @@
 #include <gridtools/common/hymap.hpp>
 #include <gridtools/common/integral_constant.hpp>
 #include <gridtools/common/tuple_util.hpp>
+#include <gridtools/sid/arena_kind.hpp>
 #include <gridtools/sid/simple_ptr_holder.hpp>
 #include <gridtools/sid/synthetic.hpp>
 
@@ -140,6 +141,84 @@ namespace gridtools {
             EXPECT_EQ(&four[1][2][3], at_key<d>(ptr));
         }
 
+        TEST(composite, grouped_pointers) {
+            // `a`, `b` and `c` point into one arena
+            double fields[3][4][3][5] = {};
+            int four[4][3][5] = {};
+
+            auto my_strides = tu::make<array>(1, 5, 15);
+            auto make_sid = [&](auto *ptr) {
+                return sid::synthetic()
+                    .set<property::origin>(sid::host_device::make_simple_ptr_holder(ptr))
+                    .template set<property::strides>(my_strides)
+                    .template set<property::strides_kind, sid::arena_kind<my_strides_kind>>();
+            };
+
+            auto testee = tu::make<sid::composite::keys<a, b, c, d>::values>(make_sid(&fields[0][0][0][0]),
+                make_sid(static_cast<double const *>(&fields[1][0][0][0])),
+                make_sid(&fields[2][0][0][0]),
+                make_sid(&four[0][0][0]));
+            static_assert(is_sid<decltype(testee)>(), "");
+
+            // `a`, `b` and `c` share the base pointer, `d` has a different element type
+            using ptr_t = sid::ptr_type<decltype(testee)>;
+            static_assert(tu::size<decltype(std::declval<ptr_t>().m_bases)>::value == 2, "");
+            static_assert(std::is_same<tu::element<1, ptr_t>, double const *>(), "");
+
+            auto &&strides = sid::get_strides(testee);
+            auto ptr = sid::get_origin(testee)();
+            EXPECT_EQ(&fields[0][0][0][0], at_key<a>(ptr));
+            EXPECT_EQ(&fields[1][0][0][0], at_key<b>(ptr));
+            EXPECT_EQ(&fields[2][0][0][0], at_key<c>(ptr));
+            EXPECT_EQ(&four[0][0][0], at_key<d>(ptr));
+
+            sid::shift(ptr, sid::get_stride<dim_i>(strides), 3);
+            sid::shift(ptr, sid::get_stride<dim_j>(strides), 2_c);
+            sid::shift(ptr, sid::get_stride<dim_k>(strides), 1);
+            EXPECT_EQ(&fields[0][1][2][3], at_key<a>(ptr));
+            EXPECT_EQ(&fields[1][1][2][3], at_key<b>(ptr));
+            EXPECT_EQ(&fields[2][1][2][3], at_key<c>(ptr));
+            EXPECT_EQ(&four[1][2][3], at_key<d>(ptr));
+
+            at_key<c>(*ptr) = 42;
+            EXPECT_EQ(42, fields[2][1][2][3]);
+
+            sid::ptr_diff_type<decltype(testee)> ptr_diff{};
+            sid::shift(ptr_diff, sid::get_stride<dim_k>(strides), 3);
+            ptr = sid::get_origin(testee)() + ptr_diff;
+            EXPECT_EQ(&fields[0][3][0][0], at_key<a>(ptr));
+            EXPECT_EQ(&fields[2][3][0][0], at_key<c>(ptr));
+            EXPECT_EQ(&four[3][0][0], at_key<d>(ptr));
+        }
+
+        TEST(composite, separate_allocations) {
+            double one[4][3][5] = {};
+            double three[4][3][5] = {};
+
+            auto my_strides = tu::make<array>(1, 5, 15);
+            auto make_sid = [&](auto *ptr) {
+                return sid::synthetic()
+                    .set<property::origin>(sid::host_device::make_simple_ptr_holder(ptr))
+                    .template set<property::strides>(my_strides)
+                    .template set<property::strides_kind, my_strides_kind>();
+            };
+
+            // the strides kind doesn't tell that the pointers are in one allocation, thus they are kept apart
+            auto testee =
+                tu::make<sid::composite::keys<a, c>::values>(make_sid(&one[0][0][0]), make_sid(&three[0][0][0]));
+            using ptr_t = sid::ptr_type<decltype(testee)>;
+            static_assert(std::is_same<ptr_t, sid::composite::keys<a, c>::composite_ptr<double *, double *>>(), "");
+
+            auto &&strides = sid::get_strides(testee);
+            auto ptr = sid::get_origin(testee)();
+            sid::shift(ptr, sid::get_stride<dim_i>(strides), 3);
+            sid::shift(ptr, sid::get_stride<dim_j>(strides), 2_c);
+            sid::shift(ptr, sid::get_stride<dim_k>(strides), 1);
+            at_key<c>(*ptr) = 42;
+            EXPECT_EQ(&one[1][2][3], at_key<a>(ptr));
+            EXPECT_EQ(42, three[1][2][3]);
+        }
+
         struct dim_x;
         struct dim_y;
         struct dim_z;
@@ -0,0 +1,54 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/sid/compute_as.hpp>
+
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/sid/concept.hpp>
+#include <gridtools/sid/simple_ptr_holder.hpp>
+#include <gridtools/sid/synthetic.hpp>
+
+namespace gridtools {
+    namespace {
+        using sid::property;
+
+        TEST(compute_as, smoke) {
+            float data[3] = {1.5f, 2.5f, 3.5f};
+            auto src = sid::synthetic().set<property::origin>(sid::host_device::make_simple_ptr_holder(&data[0]));
+            auto testee = sid::compute_as<double>(src);
+            using testee_t = decltype(testee);
+
+            static_assert(is_sid<testee_t>(), "");
+            static_assert(std::is_same<sid::ptr_type<testee_t>, converting_ptr<double, float>>(), "");
+
+            auto ptr = sid::get_origin(testee)();
+            EXPECT_EQ(ptr.get(), data);
+            double val = *ptr;
+            EXPECT_EQ(val, 1.5);
+
+            *ptr = 1. / 3;
+            EXPECT_EQ(data[0], 1.f / 3);
+
+            ptr += 2;
+            *ptr += 1;
+            EXPECT_EQ(data[2], 4.5f);
+        }
+
+        TEST(compute_as, same_type) {
+            double data = 42;
+            auto src = sid::synthetic().set<property::origin>(sid::host_device::make_simple_ptr_holder(&data));
+            auto testee = sid::compute_as<double>(src);
+            static_assert(std::is_same<sid::ptr_type<decltype(testee)>, double *>(), "");
+            EXPECT_EQ(sid::get_origin(testee)(), &data);
+        }
+    } // namespace
+} // namespace gridtools
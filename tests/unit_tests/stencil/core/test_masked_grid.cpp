@@ -0,0 +1,94 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/stencil/core/masked_grid.hpp>
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil/common/extent.hpp>
+#include <gridtools/stencil/frontend/make_grid.hpp>
+
+namespace gridtools {
+    namespace stencil {
+        namespace core {
+            namespace {
+                using runs_t = std::vector<std::pair<int_t, int_t>>;
+
+                template <class Columns>
+                runs_t runs(Columns const &columns, int_t j, int_t i_begin, int_t i_end) {
+                    runs_t res;
+                    columns.for_each_run(
+                        j, i_begin, i_end, [&](int_t first, int_t last) { res.emplace_back(first, last); });
+                    return res;
+                }
+
+                // . x x . . x
+                // . . . . . .
+                // x . . . . .
+                const column_mask mask(6, 3, [](int_t i, int_t j) {
+                    return (j == 0 && (i == 1 || i == 2 || i == 5)) || (j == 2 && i == 0);
+                });
+
+                TEST(column_mask, runs) {
+                    auto columns = mask.dilate(extent<>());
+                    EXPECT_EQ(runs(columns, 0, 0, 6), (runs_t{{1, 3}, {5, 6}}));
+                    EXPECT_EQ(runs(columns, 0, 2, 6), (runs_t{{2, 3}, {5, 6}}));
+                    EXPECT_EQ(runs(columns, 0, 3, 5), runs_t{});
+                    EXPECT_EQ(runs(columns, 1, 0, 6), runs_t{});
+                    EXPECT_EQ(runs(columns, 2, 0, 6), (runs_t{{0, 1}}));
+                }
+
+                TEST(column_mask, dilate) {
+                    auto columns = mask.dilate(extent<-1, 0, 0, 1>());
+                    EXPECT_EQ(runs(columns, 0, -1, 6), (runs_t{{0, 3}, {4, 6}}));
+                    EXPECT_EQ(runs(columns, 1, -1, 6), (runs_t{{0, 3}, {4, 6}}));
+                    EXPECT_EQ(runs(columns, 2, -1, 6), (runs_t{{-1, 1}}));
+                    EXPECT_EQ(runs(columns, 3, -1, 6), (runs_t{{-1, 1}}));
+                }
+
+                TEST(column_mask, any) {
+                    auto columns = mask.dilate(extent<-1, 1, -1, 1>());
+                    EXPECT_TRUE(columns.any(-1, 7, -1, 4));
+                    EXPECT_TRUE(columns.any(3, 4, 1, 2));
+                    EXPECT_FALSE(columns.any(2, 4, 2, 4));
+                    EXPECT_FALSE(columns.any(4, 7, 2, 4));
+                }
+
+                TEST(column_mask, cached) {
+                    EXPECT_EQ(&mask.dilate(extent<-1, 0, 0, 1>()), &mask.dilate(extent<-1, 0, 0, 1>()));
+                    EXPECT_NE(&mask.dilate(extent<-1, 0, 0, 1>()), &mask.dilate(extent<0, 1, 0, 1>()));
+                }
+
+                TEST(mask_columns, index_list) {
+                    auto grid = mask_columns(make_grid(4, 2, 5), {{1, 0}, {2, 0}, {3, 1}});
+                    auto columns = active_columns(extent<>(), grid);
+                    EXPECT_EQ(runs(columns, 0, 0, 4), (runs_t{{1, 3}}));
+                    EXPECT_EQ(runs(columns, 1, 0, 4), (runs_t{{3, 4}}));
+                    EXPECT_EQ(grid.k_size(), 5);
+                }
+
+                TEST(mask_columns, index_out_of_range) {
+                    EXPECT_THROW(mask_columns(make_grid(4, 2, 5), {{1, 0}, {4, 0}}), std::out_of_range);
+                    EXPECT_THROW(mask_columns(make_grid(4, 2, 5), {{0, -1}}), std::out_of_range);
+                }
+
+                TEST(mask_columns, plain_grid) {
+                    auto columns = active_columns(extent<-1, 1>(), make_grid(4, 2, 5));
+                    EXPECT_EQ(runs(columns, 0, -1, 5), (runs_t{{-1, 5}}));
+                    EXPECT_TRUE(columns.any(0, 0, 0, 0));
+                }
+            } // namespace
+        }     // namespace core
+    }         // namespace stencil
+} // namespace gridtools
@@ -0,0 +1,141 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/stencil/cpu_ifirst/pcr.hpp>
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/common/omp.hpp>
+#include <gridtools/stencil/be_api.hpp>
+#include <gridtools/stencil/cartesian.hpp>
+#include <gridtools/stencil/core/convert_fe_to_be_spec.hpp>
+#include <gridtools/stencil/cpu_ifirst.hpp>
+#include <gridtools/storage/builder.hpp>
+#include <gridtools/storage/cpu_ifirst.hpp>
+#include <gridtools/storage/sid.hpp>
+#include <gridtools/thread_pool/omp.hpp>
+
+namespace gridtools {
+    namespace stencil {
+        namespace {
+            using namespace cartesian;
+            using namespace cpu_ifirst_backend;
+
+            double expected(int i, int j, int k) { return 1 + std::sin(.3 * i + .2 * j + .1 * k); }
+            double lower(int i, int, int k) { return -1 + .1 * ((i + k) % 3); }
+            double upper(int, int j, int k) { return -1 + .1 * ((j + 2 * k) % 5); }
+            double center(int i, int j, int k) { return 5 + .1 * ((i + j + k) % 4); }
+
+            auto make_rhs(int k_size) {
+                return [k_size](int i, int j, int k) {
+                    auto res = center(i, j, k) * expected(i, j, k);
+                    if (k > 0)
+                        res += lower(i, j, k) * expected(i, j, k - 1);
+                    if (k < k_size - 1)
+                        res += upper(i, j, k) * expected(i, j, k + 1);
+                    return res;
+                };
+            }
+
+            const auto builder = storage::builder<storage::cpu_ifirst>.type<double>();
+
+            template <class Out>
+            void verify(Out const &out, int i_size, int j_size, int k_size) {
+                auto view = out->const_host_view();
+                for (int i = 0; i < i_size; ++i)
+                    for (int j = 0; j < j_size; ++j)
+                        for (int k = 0; k < k_size; ++k)
+                            EXPECT_NEAR(view(i, j, k), expected(i, j, k), 1e-12) << i << ", " << j << ", " << k;
+            }
+
+            class pcr : public testing::TestWithParam<int> {};
+
+            TEST_P(pcr, solve) {
+                int k_size = GetParam();
+                auto b = builder.dimensions(5, 3, k_size);
+                auto inf = b.initializer(lower).build();
+                auto diag = b.initializer(center).build();
+                auto sup = b.initializer(upper).build();
+                auto rhs = b.initializer(make_rhs(k_size)).build();
+                auto out = b.build();
+
+                solve_tridiagonal_pcr<thread_pool::omp, double>(5, 3, 0, k_size, inf, diag, sup, rhs, out);
+
+                verify(out, 5, 3, k_size);
+            }
+
+            INSTANTIATE_TEST_SUITE_P(k_sizes, pcr, testing::Values(1, 2, 3, 7, 16, 33, 100));
+
+            const auto spec = [](auto inf, auto diag, auto sup, auto rhs, auto out) {
+                return solve_tridiagonal<double, axis<1>::full_interval>(inf, diag, sup, rhs, out);
+            };
+
+            template <size_t I>
+            using arg = frontend_impl_::arg<I>;
+
+            using storage_t = decltype(builder.dimensions(1, 1, 1).build());
+
+            template <class Spec, class... Args>
+            using system_t = be_api::tridiagonal_system<be_api::make_split_view<core::convert_fe_to_be_spec<Spec,
+                axis<1>::full_interval,
+                typename hymap::keys<Args...>::template values<std::conditional_t<true, storage_t, Args> &...>>>>;
+
+            using spec_t = decltype(spec(arg<0>(), arg<1>(), arg<2>(), arg<3>(), arg<4>()));
+            static_assert(std::is_same<system_t<spec_t, arg<0>, arg<1>, arg<2>, arg<3>, arg<4>>,
+                              meta::list<double, axis<1>::full_interval, arg<0>, arg<1>, arg<2>, arg<3>, arg<4>>>(),
+                "");
+
+            struct copy_function {
+                using out = inout_accessor<0>;
+                using in = in_accessor<1>;
+                using param_list = make_param_list<out, in>;
+
+                template <class Eval>
+                GT_FUNCTION static void apply(Eval &&eval) {
+                    eval(out()) = eval(in());
+                }
+            };
+
+            using fused_spec_t = decltype(fuse(spec(arg<0>(), arg<1>(), arg<2>(), arg<3>(), arg<4>()),
+                execute_parallel().stage(copy_function(), arg<5>(), arg<4>())));
+            static_assert(
+                meta::is_empty<system_t<fused_spec_t, arg<0>, arg<1>, arg<2>, arg<3>, arg<4>, arg<5>>>(), "");
+
+            using solve_system_t = system_t<spec_t, arg<0>, arg<1>, arg<2>, arg<3>, arg<4>>;
+
+            TEST(pcr, selected_for_few_columns) {
+                int k_size = 40;
+                auto b = builder.dimensions(1, 2, k_size);
+                auto out = b.build();
+
+                int threads = omp_get_max_threads();
+                omp_set_num_threads(4);
+                auto grid = make_grid(1, 2, k_size);
+                EXPECT_TRUE(use_pcr<thread_pool::omp>(solve_system_t(), execinfo(thread_pool::omp(), grid)));
+                EXPECT_FALSE(use_pcr<thread_pool::omp>(meta::list<>(), execinfo(thread_pool::omp(), grid)));
+                EXPECT_FALSE(use_pcr<thread_pool::omp>(
+                    solve_system_t(), execinfo(thread_pool::omp(), make_grid(64, 64, k_size))));
+                run(spec,
+                    cpu_ifirst<>(),
+                    grid,
+                    b.initializer(lower).build(),
+                    b.initializer(center).build(),
+                    b.initializer(upper).build(),
+                    b.initializer(make_rhs(k_size)).build(),
+                    out);
+                omp_set_num_threads(threads);
+
+                verify(out, 1, 2, k_size);
+            }
+        } // namespace
+    }     // namespace stencil
+} // namespace gridtools
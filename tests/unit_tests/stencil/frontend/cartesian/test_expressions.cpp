@@ -28,6 +28,15 @@ namespace gridtools {
             template <class T>
             struct is_accessor<accessor_mock<T>> : std::true_type {};
 
+            struct offset_mock {
+                int offset;
+            };
+
+            template <>
+            struct is_accessor<offset_mock> : std::true_type {};
+
+            bool operator==(offset_mock lhs, offset_mock rhs) { return lhs.offset == rhs.offset; }
+
             namespace {
 
                 struct iterate_domain_mock {
@@ -95,6 +104,98 @@ namespace gridtools {
 
                     ASSERT_DOUBLE_EQ(result, 3);
                 }
+
+                /*
+                 * Rewriting and evaluation of the rewritten tree
+                 */
+                // loads `offset + 1` and counts the loads
+                struct counting_mock {
+                    int &loads;
+
+                    double operator()(offset_mock acc) const {
+                        ++loads;
+                        return acc.offset + 1;
+                    }
+
+                    template <class Op, class... Args>
+                    double operator()(expr<Op, Args...> const &arg) const {
+                        return evaluation::value(*this, arg);
+                    }
+                };
+
+                using o = offset_mock;
+
+                template <class Expr>
+                double evaluate(Expr const &expr, int &loads) {
+                    loads = 0;
+                    return counting_mock{loads}(expr);
+                }
+
+                TEST(test_expressions, fma_contraction) {
+                    using evaluation_impl_::rewrite;
+                    static_assert(std::is_same<decltype(rewrite::apply(val{1} * val{2} + val{3})),
+                                      expr<fma_f, val, val, val>>::value,
+                        "");
+                    static_assert(std::is_same<decltype(rewrite::apply(val{3} + val{1} * val{2})),
+                                      expr<fma_f, val, val, val>>::value,
+                        "");
+                    static_assert(std::is_same<decltype(rewrite::apply(val{1} * val{2} - val{3})),
+                                      expr<fma_f, val, val, expr<minus_f, val>>>::value,
+                        "");
+                    static_assert(std::is_same<decltype(rewrite::apply(val{3} - val{1} * 2.)),
+                                      expr<fma_f, expr<minus_f, val>, double, val>>::value,
+                        "");
+                    static_assert(std::is_same<decltype(rewrite::apply(val{3} - 2. * val{1})),
+                                      expr<fma_f, double, val, val>>::value,
+                        "");
+
+                    int loads;
+                    EXPECT_DOUBLE_EQ(evaluate(o{1} * o{2} + o{3}, loads), 10);
+                    EXPECT_DOUBLE_EQ(evaluate(o{3} + o{1} * o{2}, loads), 10);
+                    EXPECT_DOUBLE_EQ(evaluate(o{1} * o{2} - o{3}, loads), 2);
+                    EXPECT_DOUBLE_EQ(evaluate(o{3} - o{1} * o{2}, loads), -2);
+                    EXPECT_DOUBLE_EQ(evaluate(o{3} - 2. * o{1}, loads), 0);
+                }
+
+                TEST(test_expressions, sign_simplification) {
+                    using evaluation_impl_::rewrite;
+                    static_assert(std::is_same<decltype(rewrite::apply(-(-val{1}))), val>::value, "");
+                    static_assert(std::is_same<decltype(rewrite::apply(+val{1})), val>::value, "");
+                    static_assert(std::is_same<decltype(rewrite::apply(pow<1>(val{1}))), val>::value, "");
+                    static_assert(
+                        std::is_same<decltype(rewrite::apply(val{1} + -val{2})), expr<minus_f, val, val>>::value, "");
+                    static_assert(
+                        std::is_same<decltype(rewrite::apply(val{1} - -val{2})), expr<plus_f, val, val>>::value, "");
+                    static_assert(
+                        std::is_same<decltype(rewrite::apply(-val{1} + val{2})), expr<minus_f, val, val>>::value, "");
+
+                    int loads;
+                    EXPECT_DOUBLE_EQ(evaluate(-(-o{1}), loads), 2);
+                    EXPECT_DOUBLE_EQ(evaluate(o{1} + -o{2}, loads), -1);
+                    EXPECT_DOUBLE_EQ(evaluate(o{1} - -o{2}, loads), 5);
+                    EXPECT_DOUBLE_EQ(evaluate(-o{1} + o{2}, loads), 1);
+                }
+
+                TEST(test_expressions, leaves_are_loaded_once) {
+                    int loads;
+                    EXPECT_DOUBLE_EQ(evaluate((o{0} + o{1}) * (o{0} - o{1}), loads), -3);
+                    EXPECT_EQ(loads, 2);
+                    EXPECT_DOUBLE_EQ(evaluate(o{1} * o{1} * o{1} + o{2}, loads), 11);
+                    EXPECT_EQ(loads, 2);
+                    EXPECT_DOUBLE_EQ(evaluate(o{0} + o{1} + o{2}, loads), 6);
+                    EXPECT_EQ(loads, 3);
+                }
+
+                TEST(test_expressions, shared_reciprocal) {
+                    int loads;
+                    EXPECT_DOUBLE_EQ(evaluate(o{0} / (o{1} - o{2}) + o{3} / (o{1} - o{2}), loads), -5);
+                    EXPECT_EQ(loads, 4);
+                    EXPECT_DOUBLE_EQ(evaluate(o{0} / o{3} - o{1} / o{3}, loads), -.25);
+                    EXPECT_EQ(loads, 3);
+                    // equal types, different offsets
+                    EXPECT_DOUBLE_EQ(evaluate(o{0} / o{1} + o{1} / o{3}, loads), 1);
+                    EXPECT_EQ(loads, 3);
+                }
             } // namespace
         }     // namespace cartesian
     }         // namespace stencil
@@ -0,0 +1,95 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil/cartesian.hpp>
+
+#include <stencil_select.hpp>
+#include <test_environment.hpp>
+
+namespace {
+    using namespace gridtools;
+    using namespace stencil;
+    using namespace cartesian;
+
+    struct lap_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+
+        using param_list = make_param_list<out, in>;
+
+        template <class Eval>
+        GT_FUNCTION static void apply(Eval &&eval) {
+            eval(out()) = 4 * eval(in()) - (eval(in(1, 0)) + eval(in(0, 1)) + eval(in(-1, 0)) + eval(in(0, -1)));
+        }
+    };
+
+    struct scale_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1>;
+
+        using param_list = make_param_list<out, in>;
+
+        template <class Eval>
+        GT_FUNCTION static void apply(Eval &&eval) {
+            eval(out()) = 2 * eval(in());
+        }
+    };
+
+    const auto smooth = [](auto in, auto out) {
+        GT_DECLARE_TMP(double, tmp);
+        return execute_parallel().stage(scale_function(), tmp, in).stage(lap_function(), out, tmp);
+    };
+
+    const auto diffuse = [](auto in, auto out) {
+        GT_DECLARE_TMP(double, lap);
+        return execute_parallel().stage(lap_function(), lap, in).stage(scale_function(), out, lap);
+    };
+
+    using env_t = test_environment<2>::apply<stencil_backend_t, double, inlined_params<12, 11, 9>>;
+
+    using fuse_test = regression_test<env_t>;
+
+    TEST_F(fuse_test, fused_specs) {
+        auto in = [](int i, int j, int k) { return i * i + j * (j + k) + .5 * k; };
+        auto lap = [](auto f) {
+            return [f](int i, int j, int k) {
+                return 4 * f(i, j, k) - (f(i + 1, j, k) + f(i, j + 1, k) + f(i - 1, j, k) + f(i, j - 1, k));
+            };
+        };
+        auto mid = env_t::make_storage();
+        auto out = env_t::make_storage();
+        auto fused = [](auto in, auto mid, auto out) { return fuse(smooth(in, mid), diffuse(mid, out)); };
+        run(fused, stencil_backend_t(), env_t::make_grid(), env_t::make_storage(in), mid, out);
+        auto expected_mid = [&](int i, int j, int k) { return 2 * lap(in)(i, j, k); };
+        env_t::verify(expected_mid, mid);
+        env_t::verify([&](int i, int j, int k) { return 2 * lap(expected_mid)(i, j, k); }, out);
+    }
+
+    TEST_F(fuse_test, same_as_separate_runs) {
+        auto in = [](int i, int j, int k) { return i + j * k + .25; };
+        auto mid = env_t::make_storage();
+        auto out = env_t::make_storage();
+        auto ref_mid = env_t::make_storage();
+        auto ref_out = env_t::make_storage();
+        auto grid = env_t::make_grid();
+        auto src = env_t::make_const_storage(in);
+        run(smooth, stencil_backend_t(), grid, src, ref_mid);
+        run(diffuse, stencil_backend_t(), grid, ref_mid, ref_out);
+        run([](auto in, auto mid, auto out) { return fuse(smooth(in, mid), diffuse(mid, out)); },
+            stencil_backend_t(),
+            grid,
+            src,
+            mid,
+            out);
+        env_t::verify(ref_out, out);
+    }
+} // namespace
@@ -0,0 +1,56 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/stencil/cartesian.hpp>
+
+using namespace gridtools;
+using namespace stencil;
+using namespace cartesian;
+
+struct produce {
+    using in = in_accessor<0>;
+    using out = inout_accessor<1>;
+    using param_list = make_param_list<in, out>;
+
+    template <class Eval>
+    GT_FUNCTION static void apply(Eval &&eval) {
+        eval(out()) = 2 * eval(in());
+    }
+};
+
+struct consume {
+    using in = in_accessor<0, extent<-1, 1>>;
+    using out = inout_accessor<1>;
+    using param_list = make_param_list<in, out>;
+
+    template <class Eval>
+    GT_FUNCTION static void apply(Eval &&eval) {
+        eval(out()) = eval(in(-1, 0)) + eval(in(1, 0));
+    }
+};
+
+template <class Spec>
+constexpr bool is_local(Spec) {
+    return frontend_impl_::inlined_tmps_are_local<Spec>::value;
+}
+
+struct a {};
+struct b {};
+struct c {};
+using tmp = tmp_arg<0, double>;
+
+constexpr auto pass = execute_parallel().stage(produce(), a(), tmp()).stage(consume(), tmp(), b()).inlined(tmp());
+
+static_assert(is_local(pass), "");
+static_assert(std::is_same<decltype(get_arg_extent(pass, a())), extent<-1, 1>>::value, "");
+static_assert(is_local(multi_pass(pass, execute_parallel().stage(consume(), b(), c()))), "");
+
+// the other pass would read a temporary that is never computed
+static_assert(!is_local(multi_pass(pass, execute_parallel().stage(consume(), tmp(), c()))), "");
+static_assert(!is_local(multi_pass(execute_parallel().stage(consume(), tmp(), c()), pass)), "");
@@ -0,0 +1,62 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil/cartesian.hpp>
+
+#include <stencil_select.hpp>
+#include <test_environment.hpp>
+
+namespace {
+    using namespace gridtools;
+    using namespace stencil;
+    using namespace cartesian;
+
+    struct axpy_functor {
+        using in = in_accessor<0, extent<-1, 1>>;
+        using out = inout_accessor<1>;
+        using param_list = make_param_list<in, out>;
+
+        template <class Eval>
+        GT_FUNCTION static void apply(Eval &&eval) {
+            static_assert(std::is_same<decltype(eval(in())), double>::value, "");
+            eval(out()) += .5 * (eval(in(-1, 0, 0)) + eval(in(1, 0, 0)));
+            eval(out()) *= 2;
+        }
+    };
+
+    using env_t = test_environment<1>::apply<stencil_backend_t, double, inlined_params<12, 11, 9>>;
+
+    using mixed_precision = regression_test<env_t>;
+
+    TEST_F(mixed_precision, float_storage_double_compute) {
+        auto in = [](int i, int j, int k) { return i + j + k + .25; };
+        auto out = env_t::builder<float>().compute_type<double>().value(1).build();
+        static_assert(std::is_same<decltype(out->get_target_ptr()), float *>::value, "");
+        run_single_stage(axpy_functor(),
+            stencil_backend_t(),
+            env_t::make_grid(),
+            env_t::builder<float>().compute_type<double>().initializer(in).build(),
+            out);
+        env_t::verify([&](int i, int j, int k) { return 2 * (1 + .5 * (in(i - 1, j, k) + in(i + 1, j, k))); }, out);
+    }
+
+    TEST_F(mixed_precision, mixed_with_plain) {
+        auto in = [](int i, int j, int k) { return i + j + k + .25; };
+        auto out = env_t::make_storage(1);
+        run_single_stage(axpy_functor(),
+            stencil_backend_t(),
+            env_t::make_grid(),
+            env_t::builder<float const>().compute_type<double>().initializer(in).build(),
+            out);
+        env_t::verify([&](int i, int j, int k) { return 2 * (1 + .5 * (in(i - 1, j, k) + in(i + 1, j, k))); }, out);
+    }
+} // namespace
@@ -0,0 +1,155 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/stencil/frontend/task_graph.hpp>
+
+#include <algorithm>
+#include <atomic>
+
+#include <gtest/gtest.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <gridtools/stencil/cartesian.hpp>
+
+#include <stencil_select.hpp>
+#include <test_environment.hpp>
+
+namespace {
+    using namespace gridtools;
+    using namespace stencil;
+    using namespace cartesian;
+
+    struct copy_functor {
+        using in = in_accessor<0>;
+        using out = inout_accessor<1>;
+        using param_list = make_param_list<in, out>;
+
+        template <class Eval>
+        GT_FUNCTION static void apply(Eval &&eval) {
+            eval(out()) = eval(in());
+        }
+    };
+
+    struct scale_functor {
+        using in = in_accessor<0>;
+        using out = inout_accessor<1>;
+        using param_list = make_param_list<in, out>;
+
+        template <class Eval>
+        GT_FUNCTION static void apply(Eval &&eval) {
+            eval(out()) = 2 * eval(in());
+        }
+    };
+
+    std::atomic<int> max_team_size(0);
+
+    // records the largest number of threads that run the stage together
+    struct team_size_functor {
+        using out = inout_accessor<0>;
+        using param_list = make_param_list<out>;
+
+        template <class Eval>
+        GT_FUNCTION static void apply(Eval &&eval) {
+#ifdef _OPENMP
+            int size = omp_get_num_threads();
+            int old = max_team_size;
+            while (old < size && !max_team_size.compare_exchange_weak(old, size))
+                ;
+#endif
+            eval(out()) = 1;
+        }
+    };
+
+    auto copy_spec = [](auto in, auto out) { return execute_parallel().stage(copy_functor(), in, out); };
+    auto scale_spec = [](auto in, auto out) { return execute_parallel().stage(scale_functor(), in, out); };
+
+    using env_t = test_environment<>::apply<stencil_backend_t, double, inlined_params<13, 9, 7>>;
+
+    using task_graph_test = regression_test<env_t>;
+
+    TEST_F(task_graph_test, read_after_write) {
+        auto f = [](int i, int j, int k) { return i * 100 + j * 10 + k; };
+        auto a = env_t::make_storage(f);
+        auto b = env_t::make_storage();
+        auto c = env_t::make_storage();
+        task_graph graph;
+        graph.run(scale_spec, stencil_backend_t(), env_t::make_grid(), a, b);
+        graph.run(scale_spec, stencil_backend_t(), env_t::make_grid(), b, c);
+        graph.wait();
+        env_t::verify([&](int i, int j, int k) { return 4 * f(i, j, k); }, c);
+    }
+
+    TEST_F(task_graph_test, write_after_read) {
+        auto f = [](int i, int j, int k) { return i * 100 + j * 10 + k; };
+        auto a = env_t::make_storage(f);
+        auto b = env_t::make_storage();
+        auto c = env_t::make_storage(1.5);
+        task_graph graph;
+        graph.run(copy_spec, stencil_backend_t(), env_t::make_grid(), a, b);
+        graph.run(copy_spec, stencil_backend_t(), env_t::make_grid(), c, a);
+        graph.wait();
+        env_t::verify(f, b);
+        env_t::verify(1.5, a);
+    }
+
+    TEST_F(task_graph_test, independent_tasks) {
+        auto f = [](int i, int j, int k) { return i * 100 + j * 10 + k; };
+        auto in = env_t::make_storage(f);
+        std::vector<decltype(env_t::make_storage())> outs;
+        for (int i = 0; i != 8; ++i)
+            outs.push_back(env_t::make_storage());
+        task_graph graph(4);
+        std::vector<std::shared_future<void>> futures;
+        for (auto &&out : outs)
+            futures.push_back(graph.run(scale_spec, stencil_backend_t(), env_t::make_grid(), in, out));
+        for (auto &&future : futures)
+            future.get();
+        for (auto &&out : outs)
+            env_t::verify([&](int i, int j, int k) { return 2 * f(i, j, k); }, out);
+    }
+
+    TEST_F(task_graph_test, write_after_write) {
+        auto f = [](int i, int j, int k) { return i * 100 + j * 10 + k; };
+        auto a = env_t::make_storage(f);
+        auto b = env_t::make_storage();
+        {
+            task_graph graph;
+            graph.run(copy_spec, stencil_backend_t(), env_t::make_grid(), a, b);
+            graph.run(scale_spec, stencil_backend_t(), env_t::make_grid(), a, b);
+            graph.run(scale_spec, stencil_backend_t(), env_t::make_grid(), b, b);
+        }
+        env_t::verify([&](int i, int j, int k) { return 4 * f(i, j, k); }, b);
+    }
+
+    TEST_F(task_graph_test, threads_are_split) {
+        constexpr int tasks = 3;
+        std::vector<decltype(env_t::make_storage())> outs;
+        for (int i = 0; i != tasks; ++i)
+            outs.push_back(env_t::make_storage());
+        int threads = 1;
+#ifdef _OPENMP
+        threads = omp_get_max_threads();
+#endif
+        max_team_size = 0;
+        {
+            task_graph graph(tasks);
+            for (auto &&out : outs)
+                graph.run([](auto out) { return execute_parallel().stage(team_size_functor(), out); },
+                    stencil_backend_t(),
+                    env_t::make_grid(),
+                    out);
+        }
+        EXPECT_LE(max_team_size, std::max(threads / tasks, 1));
+        for (auto &&out : outs)
+            env_t::verify(1, out);
+    }
+} // namespace
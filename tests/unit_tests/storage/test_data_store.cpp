@@ -8,9 +8,13 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <stdexcept>
+#include <type_traits>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <gridtools/sid/arena_kind.hpp>
 #include <gridtools/storage/builder.hpp>
 
 #include <storage_select.hpp>
@@ -58,6 +62,114 @@ TEST(DataStoreTest, LambdaInitializer) {
                 EXPECT_DOUBLE_EQ(view(i, j, k), i + j + k);
 }
 
+TEST(DataStoreTest, LambdaInitializerLayouts) {
+    auto init = [](int i, int j, int k, int l) { return 1000 * i + 100 * j + 10 * k + l; };
+    auto check = [&](auto ds, int masked = -1) {
+        auto lengths = ds->lengths();
+        auto view = ds->const_host_view();
+        // masked dimensions are initialized with their last index
+        auto fix = [&](int dim, int index) { return dim == masked ? (int)lengths[dim] - 1 : index; };
+        for (int i = 0; i < lengths[0]; ++i)
+            for (int j = 0; j < lengths[1]; ++j)
+                for (int k = 0; k < lengths[2]; ++k)
+                    for (int l = 0; l < lengths[3]; ++l)
+                        EXPECT_DOUBLE_EQ(view(i, j, k, l), init(fix(0, i), fix(1, j), fix(2, k), fix(3, l)));
+    };
+    auto builder = ::builder.dimensions(5, 3, 7, 2).halos(1, 1, 0, 0).initializer(init);
+    check(builder.layout<2, 0, 3, 1>().build());
+    check(builder.layout<3, 2, 1, 0>().build());
+    check(builder.layout<1, -1, 2, 0>().build(), 1);
+    check(builder.selector<1, 1, 0, 1>().build(), 2);
+}
+
+TEST(DataStoreTest, MixedPrecision) {
+    auto ds = storage::builder<storage_traits_t>
+                  .type<float>()
+                  .compute_type<double>()
+                  .dimensions(4, 5, 6)
+                  .initializer([](int i, int j, int k) { return i + j + k + 1. / 3; })
+                  .build();
+    static_assert(std::is_same<decltype(ds->get_target_ptr()), float *>::value, "");
+    auto view = ds->host_view();
+    static_assert(std::is_same<decltype(view.data()), float *>::value, "");
+    double val = view(1, 2, 3);
+    EXPECT_EQ(val, static_cast<float>(6 + 1. / 3));
+    view(1, 2, 3) = 1. / 7;
+    EXPECT_EQ(view.data()[ds->info().index(1, 2, 3)], static_cast<float>(1. / 7));
+    auto cview = ds->const_host_view();
+    static_assert(std::is_same<decltype(static_cast<double>(cview(0, 0, 0))), double>::value, "");
+    EXPECT_EQ(static_cast<double>(cview(0, 0, 0)), static_cast<float>(1. / 3));
+}
+
+TEST(DataStoreTest, Group) {
+    auto builder = ::builder.dimensions(5, 6, 7).halos(1, 1, 0);
+    auto group = builder.initializer([](int i, int j, int k) { return i + j + k; }).build_group(3);
+    ASSERT_EQ(group.size(), 3);
+    auto ds = builder.build();
+    static_assert(std::is_same<decltype(group[0]->info()), decltype(ds->info())>::value, "");
+    auto distance = group[1]->get_target_ptr() - group[0]->get_target_ptr();
+    EXPECT_GE(distance, ds->info().length());
+    EXPECT_EQ(group[2]->get_target_ptr() - group[1]->get_target_ptr(), distance);
+
+    group[1]->host_view()(1, 2, 3) = 42;
+    EXPECT_EQ(group[0]->const_host_view()(1, 2, 3), 6);
+    EXPECT_EQ(group[1]->const_host_view()(1, 2, 3), 42);
+    EXPECT_EQ(group[2]->const_host_view()(1, 2, 3), 6);
+
+    // the members keep the arena alive
+    auto last = group[2];
+    group.clear();
+    EXPECT_EQ(last->const_host_view()(4, 5, 6), 15);
+}
+
+TEST(DataStoreTest, GroupKind) {
+    struct other_tag;
+    auto builder = ::builder.dimensions(5, 6, 7);
+    using kind_t = typename decltype(builder.build())::element_type::kind_t;
+    using group_kind_t = typename decltype(builder.build_group(2))::value_type::element_type::kind_t;
+    using other_kind_t = typename decltype(builder.build_group<other_tag>(2))::value_type::element_type::kind_t;
+    static_assert(!sid::is_arena_kind<kind_t>(), "");
+    static_assert(sid::is_arena_kind<group_kind_t>(), "");
+    static_assert(sid::is_arena_kind<other_kind_t>(), "");
+    static_assert(!std::is_same<group_kind_t, other_kind_t>(), "");
+
+    // the members of two live groups of the same kind would be mistaken for one arena
+    auto group = builder.build_group(2);
+    EXPECT_THROW(builder.build_group(3), std::runtime_error);
+    EXPECT_NO_THROW(builder.build_group<other_tag>(3));
+    group.clear();
+    EXPECT_NO_THROW(builder.build_group(3));
+}
+
+#ifndef GT_STORAGE_GPU
+TEST(DataStoreTest, Interleaved) {
+    auto builder = ::builder.dimensions(5, 6, 7).halos(1, 1, 0);
+    auto fields = builder.initializer([](int i, int j, int k) { return i + j + k; }).build_interleaved<3>();
+    auto ds = builder.build();
+    using kind_t = typename decltype(ds)::element_type::kind_t;
+    static_assert(!std::is_same<typename decltype(fields)::value_type::element_type::kind_t, kind_t>(), "");
+
+    // the padded length of the stride-1 dimension
+    using layout_t = typename decltype(ds)::element_type::layout_t;
+    auto strides = ds->strides();
+    auto row = strides[layout_t::find(layout_t::max_arg - 1)];
+    for (int n = 0; n != 3; ++n) {
+        EXPECT_EQ(fields[n]->get_target_ptr() - fields[0]->get_target_ptr(), n * row);
+        for (int d = 0; d != 3; ++d)
+            EXPECT_EQ(fields[n]->strides()[d], strides[d] == 1 ? 1 : 3 * strides[d]);
+    }
+
+    fields[1]->host_view()(1, 2, 3) = 42;
+    for (int n = 0; n != 3; ++n) {
+        auto view = fields[n]->const_host_view();
+        for (int i = 0; i != 5; ++i)
+            for (int j = 0; j != 6; ++j)
+                for (int k = 0; k != 7; ++k)
+                    EXPECT_EQ(view(i, j, k), n == 1 && i == 1 && j == 2 && k == 3 ? 42 : i + j + k);
+    }
+}
+#endif
+
 TEST(DataStoreTest, Naming) {
     auto builder = ::builder.dimensions(10, 11, 12);
     // no naming
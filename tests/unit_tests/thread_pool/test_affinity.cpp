@@ -0,0 +1,62 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/thread_pool/affinity.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace gridtools {
+    namespace thread_pool {
+        namespace affinity {
+            namespace {
+                using v_t = std::vector<int>;
+
+                TEST(parse_cpu_list, smoke) {
+                    EXPECT_EQ(parse_cpu_list(""), v_t{});
+                    EXPECT_EQ(parse_cpu_list("3"), v_t{3});
+                    EXPECT_EQ(parse_cpu_list("0-3"), (v_t{0, 1, 2, 3}));
+                    EXPECT_EQ(parse_cpu_list("0-1,8,10-11\n"), (v_t{0, 1, 8, 10, 11}));
+                    EXPECT_EQ(parse_cpu_list("4,0-1,1"), (v_t{0, 1, 4}));
+                }
+
+                TEST(parse_cpu_list, errors) {
+                    EXPECT_THROW(parse_cpu_list("a"), std::runtime_error);
+                    EXPECT_THROW(parse_cpu_list("3-1"), std::runtime_error);
+                }
+
+                TEST(exclude, smoke) { EXPECT_EQ(exclude({0, 1, 2, 3, 4}, {1, 3, 7}), (v_t{0, 2, 4})); }
+
+#ifdef __linux__
+                TEST(online_cpus, smoke) {
+                    auto cpus = online_cpus();
+                    ASSERT_FALSE(cpus.empty());
+                    EXPECT_FALSE(first_core_siblings(cpus).empty());
+                }
+
+                TEST(allowed_cpus, pin_and_restore) {
+                    auto cpus = allowed_cpus();
+                    ASSERT_FALSE(cpus.empty());
+                    auto online = online_cpus();
+                    for (int cpu : cpus)
+                        EXPECT_TRUE(std::find(online.begin(), online.end(), cpu) != online.end()) << cpu;
+                    auto saved = current_thread_cpus();
+                    EXPECT_TRUE(pin_current_thread(cpus.back()));
+                    EXPECT_EQ(current_thread_cpus(), v_t{cpus.back()});
+                    EXPECT_TRUE(pin_current_thread(saved));
+                    EXPECT_EQ(current_thread_cpus(), saved);
+                }
+#endif
+            } // namespace
+        }     // namespace affinity
+    }         // namespace thread_pool
+} // namespace gridtools
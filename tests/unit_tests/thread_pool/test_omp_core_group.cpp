@@ -0,0 +1,132 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/thread_pool/omp_core_group.hpp>
+
+#include <atomic>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil/cartesian.hpp>
+#include <gridtools/stencil/cpu_ifirst.hpp>
+#include <gridtools/thread_pool/concept.hpp>
+
+#define GT_STENCIL_CPU_IFIRST
+#include <stencil_select.hpp>
+#include <test_environment.hpp>
+
+namespace gridtools {
+    namespace thread_pool {
+        namespace {
+            struct last_cpu {
+                static std::vector<int> cores() { return {affinity::allowed_cpus().back()}; }
+            };
+
+            // two threads on the first and the last allowed CPUs, in both orders
+            struct first_and_last_cpus {
+                static std::vector<int> cores() {
+                    auto cpus = affinity::allowed_cpus();
+                    return {cpus.front(), cpus.back()};
+                }
+            };
+
+            struct last_and_first_cpus {
+                static std::vector<int> cores() {
+                    auto cpus = affinity::allowed_cpus();
+                    return {cpus.back(), cpus.front()};
+                }
+            };
+
+            using pool_t = omp_core_group<last_cpu>;
+
+            TEST(omp_core_group, max_threads) { EXPECT_EQ(get_max_threads(pool_t()), 1); }
+
+            TEST(omp_core_group, loops) {
+                std::vector<std::atomic<int>> counts(3 * 4 * 5);
+                parallel_for_loop(
+                    pool_t(), [&](int i, int j, int k) { ++counts[i + 3 * j + 12 * k]; }, 3, 4, 5);
+                parallel_for_loop(
+                    pool_t(), [&](int i, int j) { ++counts[i + 3 * j]; }, 3, 20);
+                parallel_for_loop(
+                    pool_t(), [&](int i) { ++counts[i]; }, 60);
+                for (auto &&count : counts)
+                    EXPECT_EQ(count, 3);
+            }
+
+#ifdef __linux__
+            TEST(omp_core_group, placement) {
+                std::atomic<int> misplaced(0);
+                parallel_for_loop(
+                    pool_t(),
+                    [&](int) {
+                        if (sched_getcpu() != last_cpu::cores().front())
+                            ++misplaced;
+                    },
+                    100);
+                EXPECT_EQ(misplaced, 0);
+            }
+
+            template <class Pool>
+            int count_misplaced() {
+                std::atomic<int> res(0);
+                parallel_for_loop(
+                    Pool(),
+                    [&](int) {
+                        if (sched_getcpu() != Pool::cores()[get_thread_num(Pool())])
+                            ++res;
+                    },
+                    100);
+                return res;
+            }
+
+            TEST(omp_core_group, placement_after_another_group) {
+                using pool1_t = omp_core_group<first_and_last_cpus>;
+                using pool2_t = omp_core_group<last_and_first_cpus>;
+                EXPECT_EQ(count_misplaced<pool1_t>(), 0);
+                EXPECT_EQ(count_misplaced<pool2_t>(), 0);
+                EXPECT_EQ(count_misplaced<pool1_t>(), 0);
+            }
+
+            TEST(omp_core_group, restores_affinity) {
+                auto saved = affinity::current_thread_cpus();
+                parallel_for_loop(
+                    pool_t(), [](int) {}, 10);
+                EXPECT_EQ(affinity::current_thread_cpus(), saved);
+            }
+#endif
+
+            struct copy_functor {
+                using in = stencil::cartesian::in_accessor<0>;
+                using out = stencil::cartesian::inout_accessor<1>;
+                using param_list = stencil::make_param_list<in, out>;
+
+                template <class Eval>
+                GT_FUNCTION static void apply(Eval &&eval) {
+                    eval(out()) = eval(in());
+                }
+            };
+
+            using backend_t = stencil::cpu_ifirst<pool_t>;
+            using env_t = test_environment<>::apply<backend_t, double, inlined_params<12, 7, 5>>;
+
+            TEST(omp_core_group, stencil) {
+                auto in = [](int i, int j, int k) { return i + j + k; };
+                auto out = env_t::make_storage();
+                stencil::run_single_stage(
+                    copy_functor(), backend_t(), env_t::make_grid(), env_t::make_storage(in), out);
+                env_t::verify(in, out);
+            }
+        } // namespace
+    }     // namespace thread_pool
+} // namespace gridtools